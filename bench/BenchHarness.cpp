@@ -0,0 +1,192 @@
+#include "BenchHarness.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+namespace bench {
+
+namespace {
+
+struct Registration {
+    std::string name;
+    BenchFn fn;
+    std::vector<int64_t> args;
+};
+
+std::vector<Registration>& registry() {
+    static std::vector<Registration> benchmarks;
+    return benchmarks;
+}
+
+struct Result {
+    std::string name;
+    int64_t iterations;
+    double nsPerIteration;
+    double bytesPerSecond;
+    double itemsPerSecond;
+};
+
+std::string jsonEscape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+const char* buildType() {
+#ifdef NDEBUG
+    return "release";
+#else
+    return "debug";
+#endif
+}
+
+const char* compilerName() {
+#if defined(__clang__)
+    return "clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    return "msvc";
+#else
+    return "unknown";
+#endif
+}
+
+bool writeJson(const std::string& path, const char* executable, const std::vector<Result>& results) {
+    std::ofstream out(path);
+    if (!out.is_open()) return false;
+
+    char date[64];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    out << "{\n  \"context\": {\n"
+        << "    \"date\": \"" << date << "\",\n"
+        << "    \"executable\": \"" << jsonEscape(executable) << "\",\n"
+        << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+        << "    \"library_build_type\": \"" << buildType() << "\",\n"
+        << "    \"compiler\": \"" << jsonEscape(compilerName()) << "\"\n"
+        << "  },\n  \"benchmarks\": [\n";
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        out << "    {\n"
+            << "      \"name\": \"" << jsonEscape(r.name) << "\",\n"
+            << "      \"run_type\": \"iteration\",\n"
+            << "      \"iterations\": " << r.iterations << ",\n"
+            << "      \"real_time\": " << r.nsPerIteration << ",\n"
+            << "      \"cpu_time\": " << r.nsPerIteration << ",\n"
+            << "      \"time_unit\": \"ns\"";
+        if (r.bytesPerSecond > 0) out << ",\n      \"bytes_per_second\": " << r.bytesPerSecond;
+        if (r.itemsPerSecond > 0) out << ",\n      \"items_per_second\": " << r.itemsPerSecond;
+        out << "\n    }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+    return true;
+}
+
+} // namespace
+
+State::State(int64_t iterations, const std::vector<int64_t>& args)
+    : m_iterations(iterations), m_args(args), m_elapsedNs(0),
+      m_running(false), m_bytes(0), m_items(0) {}
+
+void State::pauseTiming() {
+    if (!m_running) return;
+    m_elapsedNs += std::chrono::duration<double, std::nano>(Clock::now() - m_start).count();
+    m_running = false;
+}
+
+void State::resumeTiming() {
+    if (m_running) return;
+    m_start = Clock::now();
+    m_running = true;
+}
+
+State::Iterator State::begin() {
+    resumeTiming();
+    return Iterator{this, m_iterations};
+}
+
+bool State::Iterator::operator!=(const Iterator&) const {
+    if (remaining > 0) return true;
+    state->pauseTiming();
+    return false;
+}
+
+void registerBenchmark(const std::string& name, BenchFn fn,
+                       const std::vector<std::vector<int64_t>>& argSets) {
+    for (const auto& args : argSets) {
+        std::string fullName = name;
+        for (int64_t a : args) fullName += "/" + std::to_string(a);
+        registry().push_back({fullName, fn, args});
+    }
+}
+
+int runAll(int argc, char* argv[]) {
+    std::string jsonPath;
+    std::string filter;
+    double minTime = 0.5;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--json" && i + 1 < argc) jsonPath = argv[++i];
+        else if (arg == "--filter" && i + 1 < argc) filter = argv[++i];
+        else if (arg == "--min-time" && i + 1 < argc) minTime = std::atof(argv[++i]);
+        else {
+            std::cerr << "Usage: " << argv[0] << " [--json file] [--filter substring] [--min-time seconds]\n";
+            return 2;
+        }
+    }
+
+    std::vector<Result> results;
+    std::printf("%-48s %14s %12s %16s\n", "Benchmark", "Time/iter", "Iterations", "Throughput");
+
+    for (const auto& reg : registry()) {
+        if (!filter.empty() && reg.name.find(filter) == std::string::npos) continue;
+
+        // Grow the iteration count until one run lasts at least minTime
+        int64_t iterations = 1;
+        double elapsed = 0;
+        State state(iterations, reg.args);
+        for (;;) {
+            state = State(iterations, reg.args);
+            reg.fn(state);
+            elapsed = state.elapsedNs();
+            if (elapsed >= minTime * 1e9 || iterations >= 1000000000) break;
+            double perIter = std::max(elapsed / iterations, 1.0);
+            int64_t predicted = static_cast<int64_t>(minTime * 1e9 / perIter * 1.4);
+            iterations = std::clamp<int64_t>(predicted, iterations + 1, iterations * 10);
+        }
+
+        Result r;
+        r.name = reg.name;
+        r.iterations = state.iterations();
+        r.nsPerIteration = elapsed / r.iterations;
+        double seconds = elapsed / 1e9;
+        r.bytesPerSecond = state.bytesProcessed() > 0 ? state.bytesProcessed() / seconds : 0;
+        r.itemsPerSecond = state.itemsProcessed() > 0 ? state.itemsProcessed() / seconds : 0;
+        results.push_back(r);
+
+        char throughput[32] = "";
+        if (r.bytesPerSecond > 0) std::snprintf(throughput, sizeof(throughput), "%.1f MB/s", r.bytesPerSecond / 1e6);
+        else if (r.itemsPerSecond > 0) std::snprintf(throughput, sizeof(throughput), "%.3g items/s", r.itemsPerSecond);
+        std::printf("%-48s %11.0f ns %12lld %16s\n", r.name.c_str(), r.nsPerIteration,
+                    static_cast<long long>(r.iterations), throughput);
+    }
+
+    if (!jsonPath.empty() && !writeJson(jsonPath, argv[0], results)) {
+        std::cerr << "Could not write " << jsonPath << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace bench
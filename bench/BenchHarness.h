@@ -0,0 +1,83 @@
+#ifndef BENCHHARNESS_H
+#define BENCHHARNESS_H
+
+// Minimal self-contained benchmark harness. The API mirrors the subset of
+// Google Benchmark we need (range-for state loop, pause/resume, byte and item
+// counters) and the JSON it writes uses the same field names, so results can
+// be diffed across commits with the usual tooling.
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+class State {
+public:
+    State(int64_t iterations, const std::vector<int64_t>& args);
+
+    int64_t range(size_t index = 0) const { return m_args.at(index); }
+    int64_t iterations() const { return m_iterations; }
+
+    // Exclude per-iteration setup from the measurement
+    void pauseTiming();
+    void resumeTiming();
+
+    void setBytesProcessed(int64_t bytes) { m_bytes = bytes; }
+    void setItemsProcessed(int64_t items) { m_items = items; }
+
+    // Range-for support: for (auto _ : state) { ... }
+    struct Value {
+        ~Value() {}   // Non-trivial so an unused loop variable does not warn
+    };
+    struct Iterator {
+        State* state;
+        int64_t remaining;
+        bool operator!=(const Iterator& other) const;
+        void operator++() { --remaining; }
+        Value operator*() const { return Value(); }
+    };
+    Iterator begin();
+    Iterator end() { return Iterator{this, 0}; }
+
+    double elapsedNs() const { return m_elapsedNs; }
+    int64_t bytesProcessed() const { return m_bytes; }
+    int64_t itemsProcessed() const { return m_items; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    int64_t m_iterations;
+    std::vector<int64_t> m_args;
+    Clock::time_point m_start;
+    double m_elapsedNs;
+    bool m_running;
+    int64_t m_bytes;
+    int64_t m_items;
+};
+
+using BenchFn = std::function<void(State&)>;
+
+// Registers fn once per argument set; the reported name is "name/arg0/arg1..."
+void registerBenchmark(const std::string& name, BenchFn fn,
+                       const std::vector<std::vector<int64_t>>& argSets = {{}});
+
+// Keeps the optimizer from discarding a computed value
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+// Parses --json <file>, --filter <substring>, --min-time <seconds>
+int runAll(int argc, char* argv[]);
+
+} // namespace bench
+
+#endif // BENCHHARNESS_H
@@ -0,0 +1,299 @@
+#include <cstdio>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <vector>
+#include "BenchHarness.h"
+#include "core/EventManager.h"
+#include "core/MetricsRecorder.h"
+#include "core/Scheduler.h"
+#include "io/BinaryScenario.h"
+#include "io/InputParser.h"
+#include "io/OutputWriter.h"
+#include "io/ScenarioWriter.h"
+#include "tools/ScenarioGenerator.h"
+
+namespace {
+
+// Small deterministic LCG so every run benchmarks the same data
+struct Lcg {
+    uint64_t state;
+    explicit Lcg(uint64_t seed) : state(seed) {}
+    int next(int lo, int hi) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return lo + static_cast<int>((state >> 33) % static_cast<uint64_t>(hi - lo + 1));
+    }
+};
+
+struct World {
+    std::map<int, Order> orders;
+    std::map<int, Warehouse> warehouses;
+    std::map<int, Vehicle> vehicles;
+    std::vector<std::vector<int>> travelTimes;
+    std::vector<int> vipQueue;
+    std::vector<int> stdQueue;
+};
+
+// Stock is deliberately tight so a realistic share of the backlog stays blocked
+World makeWorld(int numWarehouses, int numVehicles, int backlog, int numItems = 20) {
+    Lcg rng(42);
+    World w;
+    w.travelTimes.assign(numWarehouses + 1, std::vector<int>(numWarehouses + 1, 0));
+    for (int i = 1; i <= numWarehouses; ++i) {
+        for (int j = 1; j <= numWarehouses; ++j) {
+            w.travelTimes[i][j] = (i == j) ? 0 : rng.next(5, 60);
+        }
+    }
+    for (int wid = 1; wid <= numWarehouses; ++wid) {
+        w.warehouses[wid] = Warehouse(wid, wid);
+        for (int item = 1; item <= numItems; ++item) {
+            w.warehouses[wid].setInventory(item, rng.next(0, 40));
+        }
+    }
+    for (int vid = 1; vid <= numVehicles; ++vid) {
+        w.vehicles[vid] = Vehicle(vid, VehicleType::Standard, rng.next(1, 4), rng.next(60, 150),
+                                  (vid - 1) % numWarehouses + 1);
+    }
+    for (int oid = 1; oid <= backlog; ++oid) {
+        std::vector<std::pair<int, int>> demand;
+        int lines = rng.next(1, 4);
+        for (int l = 0; l < lines; ++l) demand.push_back({rng.next(1, numItems), rng.next(1, 15)});
+        bool vip = rng.next(0, 4) == 0;
+        double value = 0;
+        for (const auto& d : demand) value += d.second;
+        w.orders[oid] = Order(oid, rng.next(0, 50), rng.next(60, 200), rng.next(1, numWarehouses),
+                              vip ? PriorityClass::VIP : PriorityClass::Standard, value, demand);
+        (vip ? w.vipQueue : w.stdQueue).push_back(oid);
+    }
+    return w;
+}
+
+std::vector<EventPtr> makeEvents(int count, int distinctTimes) {
+    Lcg rng(7);
+    std::vector<EventPtr> events;
+    events.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        events.push_back(std::make_shared<CancelEvent>(rng.next(0, distinctTimes - 1), i));
+    }
+    return events;
+}
+
+std::string tempPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+std::string scenarioPath(long long events, bool binary) {
+    return tempPath("wds_bench_" + std::to_string(events) + (binary ? ".wdsb" : ".txt"));
+}
+
+// Generates (once) a scenario with the given event count and returns its path
+std::string scenarioFile(long long events, bool binary = false) {
+    static std::map<std::pair<long long, bool>, std::string> cache;
+    auto it = cache.find({events, binary});
+    if (it != cache.end()) return it->second;
+
+    ScenarioGenerator::Config config;
+    config.numWarehouses = 100;
+    config.numItems = 50;
+    config.numVehicles = 300;
+    config.numEvents = events;
+    config.seed = 11;
+
+    std::string path = scenarioPath(events, binary);
+    TextScenarioWriter textWriter;
+    BinaryScenarioWriter binaryWriter;
+    ScenarioWriter& writer = binary ? static_cast<ScenarioWriter&>(binaryWriter) : textWriter;
+    writer.open(path);
+    ScenarioGenerator(config).generate(writer);
+    cache[{events, binary}] = path;
+    return path;
+}
+
+// ---- EventManager -----------------------------------------------------------
+
+void BM_EventManagerPush(bench::State& state) {
+    auto events = makeEvents(static_cast<int>(state.range(0)), 1000);
+    EventManager manager;
+    for (auto _ : state) {
+        state.pauseTiming();
+        manager.clear();
+        state.resumeTiming();
+        for (const auto& e : events) manager.addEvent(e);
+    }
+    state.setItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_EventManagerPop(bench::State& state) {
+    auto events = makeEvents(static_cast<int>(state.range(0)), 1000);
+    EventManager manager;
+    for (auto _ : state) {
+        state.pauseTiming();
+        for (const auto& e : events) manager.addEvent(e);
+        state.resumeTiming();
+        while (EventPtr e = manager.getNextEvent()) bench::doNotOptimize(e);
+    }
+    state.setItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_EventManagerGetEventsAt(bench::State& state) {
+    int count = static_cast<int>(state.range(0));
+    int times = std::max(1, count / 10);
+    auto events = makeEvents(count, times);
+    EventManager manager;
+    for (auto _ : state) {
+        state.pauseTiming();
+        for (const auto& e : events) manager.addEvent(e);
+        state.resumeTiming();
+        for (int t = 0; t < times; ++t) {
+            auto batch = manager.getEventsAt(t);
+            bench::doNotOptimize(batch);
+        }
+    }
+    state.setItemsProcessed(state.iterations() * count);
+}
+
+// ---- Scheduler --------------------------------------------------------------
+
+void BM_AttemptAssignments(bench::State& state) {
+    int backlog = static_cast<int>(state.range(0));
+    const World pristine = makeWorld(50, 100, backlog);
+    World w;
+    Scheduler scheduler;
+    for (auto _ : state) {
+        state.pauseTiming();
+        w = pristine;
+        scheduler = Scheduler();
+        scheduler.setData(&w.orders, &w.warehouses, &w.vehicles, &w.travelTimes);
+        for (int oid : w.vipQueue) scheduler.addVipOrder(oid);
+        for (int oid : w.stdQueue) scheduler.addStandardOrder(oid);
+        state.resumeTiming();
+        auto results = scheduler.attemptAssignments(100);
+        bench::doNotOptimize(results);
+    }
+    state.setItemsProcessed(state.iterations() * backlog);
+}
+
+void BM_FindBestWarehouse(bench::State& state) {
+    World w = makeWorld(static_cast<int>(state.range(0)), 1, 256);
+    Scheduler scheduler;
+    scheduler.setData(&w.orders, &w.warehouses, &w.vehicles, &w.travelTimes);
+    int oid = 1;
+    for (auto _ : state) {
+        bench::doNotOptimize(scheduler.findBestWarehouse(w.orders[oid]));
+        oid = oid % 256 + 1;
+    }
+    state.setItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_FindBestVehicle(bench::State& state) {
+    World w = makeWorld(10, static_cast<int>(state.range(0)), 256);
+    Scheduler scheduler;
+    scheduler.setData(&w.orders, &w.warehouses, &w.vehicles, &w.travelTimes);
+    int oid = 1;
+    for (auto _ : state) {
+        bench::doNotOptimize(scheduler.findBestVehicle(oid % 10 + 1, w.orders[oid]));
+        oid = oid % 256 + 1;
+    }
+    state.setItemsProcessed(state.iterations() * state.range(0));
+}
+
+// ---- Warehouse --------------------------------------------------------------
+
+void BM_CanFulfillOrder(bench::State& state) {
+    int lines = static_cast<int>(state.range(0));
+    Warehouse warehouse(1, 1);
+    for (int item = 1; item <= 1000; ++item) warehouse.setInventory(item, 50);
+    Lcg rng(3);
+    std::vector<std::vector<std::pair<int, int>>> demands(64);
+    for (auto& d : demands) {
+        for (int l = 0; l < lines; ++l) d.push_back({rng.next(1, 1000), rng.next(1, 40)});
+    }
+    size_t i = 0;
+    for (auto _ : state) {
+        bench::doNotOptimize(warehouse.canFulfillOrder(demands[i]));
+        i = (i + 1) & 63;
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+// ---- Metrics ----------------------------------------------------------------
+
+// One time-series sample; compare with the per-step cost of attemptAssignments
+void BM_MetricsRecord(bench::State& state) {
+    World w = makeWorld(static_cast<int>(state.range(0)), 10, 0);
+    MetricsRecorder recorder;
+    recorder.configure(4096, 1, w.warehouses);
+    int values[MetricsRecorder::ColumnCount] = {};
+    for (auto _ : state) {
+        values[MetricsRecorder::Time]++;
+        recorder.record(values);
+    }
+    bench::doNotOptimize(recorder.inventory(0, 0));
+    state.setItemsProcessed(state.iterations());
+}
+
+// ---- I/O --------------------------------------------------------------------
+
+void BM_InputParserParse(bench::State& state) {
+    std::string path = scenarioFile(state.range(0), state.range(1) != 0);
+    auto bytes = static_cast<int64_t>(std::filesystem::file_size(path));
+    for (auto _ : state) {
+        InputParser parser;
+        bench::doNotOptimize(parser.parse(path));
+    }
+    state.setBytesProcessed(state.iterations() * bytes);
+}
+
+void BM_OutputWriterWrite(bench::State& state) {
+    int delivered = static_cast<int>(state.range(0));
+    std::map<int, Order> orders;
+    std::vector<int> deliveredOrders;
+    for (int oid = 1; oid <= delivered; ++oid) {
+        Order o(oid, oid / 4, oid / 4 + 50, 1 + oid % 20, PriorityClass::Standard, 12 + oid % 30, {{1, 3}});
+        o.setAssignedWarehouse(1 + oid % 10);
+        o.setAssignedVehicle(1 + oid % 40);
+        o.setAssignTime(oid / 4 + 2);
+        o.setDispatchTime(oid / 4 + 2);
+        o.setFinishTime(oid / 4 + 9);
+        o.setStatus(OrderStatus::Delivered);
+        orders[oid] = o;
+        deliveredOrders.push_back(oid);
+    }
+    OutputWriter::Statistics stats;
+    stats.totalOrders = stats.deliveredOrders = delivered;
+
+    std::string path = tempPath("wds_bench_output.txt");
+    int64_t bytes = 0;
+    for (auto _ : state) {
+        OutputWriter writer;
+        bench::doNotOptimize(writer.write(path, orders, deliveredOrders, stats));
+    }
+    bytes = static_cast<int64_t>(std::filesystem::file_size(path));
+    std::remove(path.c_str());
+    state.setBytesProcessed(state.iterations() * bytes);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    bench::registerBenchmark("EventManager/push", BM_EventManagerPush, {{1000}, {100000}});
+    bench::registerBenchmark("EventManager/pop", BM_EventManagerPop, {{1000}, {100000}});
+    bench::registerBenchmark("EventManager/getEventsAt", BM_EventManagerGetEventsAt, {{1000}, {100000}});
+    bench::registerBenchmark("Scheduler/attemptAssignments", BM_AttemptAssignments, {{100}, {1000}, {10000}});
+    bench::registerBenchmark("Scheduler/findBestWarehouse", BM_FindBestWarehouse, {{10}, {100}, {1000}});
+    bench::registerBenchmark("Scheduler/findBestVehicle", BM_FindBestVehicle, {{100}, {1000}, {10000}});
+    bench::registerBenchmark("Warehouse/canFulfillOrder", BM_CanFulfillOrder, {{1}, {4}, {16}});
+    bench::registerBenchmark("MetricsRecorder/record", BM_MetricsRecord, {{10}, {100}, {1000}});
+    // Second argument: 0 = text, 1 = binary scenario
+    bench::registerBenchmark("InputParser/parse", BM_InputParserParse,
+                             {{10000, 0}, {100000, 0}, {10000, 1}, {100000, 1}});
+    bench::registerBenchmark("OutputWriter/write", BM_OutputWriterWrite, {{10000}, {100000}});
+
+    int rc = bench::runAll(argc, argv);
+
+    for (long long events : {10000LL, 100000LL}) {
+        std::remove(scenarioPath(events, false).c_str());
+        std::remove(scenarioPath(events, true).c_str());
+    }
+    return rc;
+}
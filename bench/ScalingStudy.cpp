@@ -0,0 +1,212 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "io/ScenarioWriter.h"
+#include "tools/ScenarioGenerator.h"
+
+// End-to-end scaling study. For every grid point a scenario is generated and
+// run in a fresh WarehouseDeliveryCli process (so peak RSS is per run); the
+// CLI appends its metrics to a CSV which is then summarised into a report
+// with the fitted complexity exponent of each Simulator::step phase.
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct Point {
+    std::string axis;
+    int warehouses;
+    int vehicles;
+    long long events;
+};
+
+enum Column {
+    Warehouses = 0, Vehicles, Events, SimTime, Steps, Completed, LoadS, RunS,
+    EventsPerS, SimUnitsPerS, PeakRssKb, EventsNs, ArrivalsNs, AssignmentsNs,
+    Orders, Delivered, ColumnCount
+};
+
+struct Row {
+    std::string label;
+    double value[ColumnCount];
+};
+
+// Least-squares slope of log(y) against log(x): y ~ x^slope
+double fitExponent(const std::vector<double>& x, const std::vector<double>& y) {
+    double n = 0, sx = 0, sy = 0, sxx = 0, sxy = 0;
+    for (size_t i = 0; i < x.size(); ++i) {
+        if (x[i] <= 0 || y[i] <= 0) continue;
+        double lx = std::log(x[i]), ly = std::log(y[i]);
+        n += 1; sx += lx; sy += ly; sxx += lx * lx; sxy += lx * ly;
+    }
+    double denom = n * sxx - sx * sx;
+    return (n < 2 || denom == 0) ? 0.0 : (n * sxy - sx * sy) / denom;
+}
+
+std::vector<Row> readMetrics(const std::string& path) {
+    std::vector<Row> rows;
+    std::ifstream in(path);
+    std::string line;
+    std::getline(in, line);   // header
+    while (std::getline(in, line)) {
+        std::stringstream ss(line);
+        Row row{};
+        std::getline(ss, row.label, ',');
+        std::string cell;
+        for (int c = 0; c < ColumnCount && std::getline(ss, cell, ','); ++c) {
+            row.value[c] = std::atof(cell.c_str());
+        }
+        rows.push_back(row);
+    }
+    return rows;
+}
+
+void writeReport(const std::string& path, const std::vector<Row>& rows) {
+    std::ofstream out(path);
+    out << "# Scaling study\n\n"
+        << "Each axis is swept with the other two held at the baseline. "
+        << "`ns/step` columns are wall time per `Simulator::step` phase; "
+        << "the exponent k is the log-log fit of total phase time against the axis (time ~ n^k).\n";
+
+    std::map<std::string, std::vector<const Row*>> byAxis;
+    for (const Row& r : rows) {
+        byAxis[r.label.substr(0, r.label.find('='))].push_back(&r);
+    }
+
+    const char* phaseNames[] = {"events", "arrivals", "assignments"};
+    const int phaseCols[] = {EventsNs, ArrivalsNs, AssignmentsNs};
+
+    for (const auto& [axis, axisRows] : byAxis) {
+        int axisCol = axis == "warehouses" ? Warehouses : axis == "vehicles" ? Vehicles : Events;
+
+        out << "\n## " << axis << "\n\n"
+            << "| " << axis << " | events/s | sim units/s | peak RSS MB | events ns/step"
+            << " | arrivals ns/step | assignments ns/step | completed |\n"
+            << "|---:|---:|---:|---:|---:|---:|---:|:-:|\n";
+
+        std::vector<double> xs;
+        std::vector<std::vector<double>> phaseTotals(3);
+        for (const Row* r : axisRows) {
+            double steps = std::max(1.0, r->value[Steps]);
+            char line[256];
+            std::snprintf(line, sizeof(line), "| %.0f | %.0f | %.0f | %.1f | %.0f | %.0f | %.0f | %s |\n",
+                          r->value[axisCol], r->value[EventsPerS], r->value[SimUnitsPerS],
+                          r->value[PeakRssKb] / 1024.0,
+                          r->value[EventsNs] / steps, r->value[ArrivalsNs] / steps,
+                          r->value[AssignmentsNs] / steps,
+                          r->value[Completed] > 0 ? "yes" : "no");
+            out << line;
+            xs.push_back(r->value[axisCol]);
+            for (int p = 0; p < 3; ++p) phaseTotals[p].push_back(r->value[phaseCols[p]]);
+        }
+
+        out << "\nComplexity (total time ~ " << axis << "^k):";
+        for (int p = 0; p < 3; ++p) {
+            char fit[64];
+            std::snprintf(fit, sizeof(fit), " %s k=%.2f%s", phaseNames[p],
+                          fitExponent(xs, phaseTotals[p]), p < 2 ? "," : "");
+            out << fit;
+        }
+        out << "\n";
+    }
+}
+
+void printUsage() {
+    std::cout <<
+        "Usage: WarehouseScalingStudy [options]\n"
+        "  --cli PATH          WarehouseDeliveryCli executable (default: next to this binary)\n"
+        "  --out DIR           Output directory for metrics.csv and report.md (default scaling)\n"
+        "  --axis NAME         Only sweep warehouses, vehicles or events\n"
+        "  --max-points N      Only the first N sizes of each axis (quick runs)\n"
+        "  --seed S            Generator seed (default 1)\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string cli = (fs::path(argv[0]).parent_path() / "WarehouseDeliveryCli").string();
+    std::string outDir = "scaling";
+    std::string onlyAxis;
+    size_t maxPoints = 100;
+    uint64_t seed = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--cli" && i + 1 < argc) cli = argv[++i];
+        else if (arg == "--out" && i + 1 < argc) outDir = argv[++i];
+        else if (arg == "--axis" && i + 1 < argc) onlyAxis = argv[++i];
+        else if (arg == "--max-points" && i + 1 < argc) maxPoints = std::strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--seed" && i + 1 < argc) seed = std::strtoull(argv[++i], nullptr, 10);
+        else { printUsage(); return arg == "-h" || arg == "--help" ? 0 : 2; }
+    }
+
+    const int baseWarehouses = 100;
+    const int baseVehicles = 1000;
+    const long long baseEvents = 100000;
+    const std::vector<int> warehouseSizes = {10, 100, 1000, 10000};
+    const std::vector<int> vehicleSizes = {10, 100, 1000, 10000, 100000};
+    const std::vector<long long> eventSizes = {1000, 10000, 100000, 1000000, 10000000};
+
+    std::vector<Point> points;
+    for (size_t i = 0; i < warehouseSizes.size() && i < maxPoints; ++i)
+        points.push_back({"warehouses", warehouseSizes[i], baseVehicles, baseEvents});
+    for (size_t i = 0; i < vehicleSizes.size() && i < maxPoints; ++i)
+        points.push_back({"vehicles", baseWarehouses, vehicleSizes[i], baseEvents});
+    for (size_t i = 0; i < eventSizes.size() && i < maxPoints; ++i)
+        points.push_back({"events", baseWarehouses, baseVehicles, eventSizes[i]});
+
+    fs::create_directories(outDir);
+    std::string metrics = (fs::path(outDir) / "metrics.csv").string();
+    std::string report = (fs::path(outDir) / "report.md").string();
+    std::string scenario = (fs::path(outDir) / "scenario.tmp").string();
+    fs::remove(metrics);
+
+    for (const Point& p : points) {
+        if (!onlyAxis.empty() && p.axis != onlyAxis) continue;
+
+        ScenarioGenerator::Config config;
+        config.seed = seed;
+        config.numWarehouses = p.warehouses;
+        config.numItems = 50;
+        config.numVehicles = p.vehicles;
+        config.numEvents = p.events;
+        config.topology = ScenarioGenerator::Topology::Clustered;
+        // Keep offered load proportional to the fleet so utilisation stays comparable
+        config.arrivalRate = std::max(1.0, p.vehicles / 50.0);
+        config.restockRate = 0.15;
+
+        std::string value = p.axis == "warehouses" ? std::to_string(p.warehouses)
+                          : p.axis == "vehicles" ? std::to_string(p.vehicles)
+                          : std::to_string(p.events);
+        std::cout << "[" << p.axis << "=" << value << "] generating..." << std::flush;
+
+        TextScenarioWriter writer;
+        ScenarioGenerator generator(config);
+        if (!writer.open(scenario) || !generator.generate(writer)) {
+            std::cerr << "\nGeneration failed: " << generator.getError() << writer.getError() << "\n";
+            return 1;
+        }
+
+        std::cout << " running..." << std::flush;
+        std::string cmd = "\"" + cli + "\" \"" + scenario + "\" --quiet --metrics-csv \"" + metrics +
+                          "\" --label " + p.axis + "=" + value;
+#ifdef _WIN32
+        cmd = "\"" + cmd + "\"";   // cmd.exe strips the outer quote pair
+#endif
+        int rc = std::system(cmd.c_str());
+        std::cout << (rc == 0 ? " done" : " FAILED") << std::endl;
+    }
+    fs::remove(scenario);
+
+    writeReport(report, readMetrics(metrics));
+    std::cout << "Metrics: " << metrics << "\nReport:  " << report << "\n";
+    return 0;
+}
@@ -0,0 +1,311 @@
+#include <QCoreApplication>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "core/Profiler.h"
+#include "core/Simulator.h"
+#include "core/Tracer.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+// Headless runner: loads a scenario, runs it to completion without the GUI
+// and prints a summary. Used directly and by the scaling study harness.
+
+namespace {
+
+long long peakRssKb() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<long long>(counters.PeakWorkingSetSize / 1024);
+    }
+    return 0;
+#else
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;   // bytes on macOS
+#else
+    return usage.ru_maxrss;          // kilobytes on Linux
+#endif
+#endif
+}
+
+void printUsage() {
+    std::cout <<
+        "Usage: WarehouseDeliveryCli <input> [options]\n"
+        "  -o, --output FILE       Write delivery results (same format as Save Results)\n"
+        "  --columnar FILE         Write delivered orders as an Arrow file, plus\n"
+        "                          FILE.vehicles.arrow and FILE.warehouses.arrow\n"
+        "  --timeseries FILE       Write per-step queue, fleet, stock and blocked-order\n"
+        "                          samples to FILE (.arrow, otherwise CSV)\n"
+        "  --sample-every N        With --timeseries, sample every Nth step (default 1)\n"
+        "  --timeseries-capacity N Keep the last N samples (default 10000)\n"
+        "  --trace FILE            Write a Chrome trace (JSON) of load, step phases and\n"
+        "                          queue/fleet counters; open it in Perfetto\n"
+        "  --stream                Read events from the file as the run reaches them\n"
+        "                          instead of loading the whole trace\n"
+        "  --reorder-window N      With --stream, sort out-of-order timestamps within\n"
+        "                          N events (default 0: input must be sorted)\n"
+        "  --max-time T            Stop at simulation time T even if orders remain\n"
+        "  --idle-limit N          Stop after N steps with no pending events and no\n"
+        "                          dispatch or delivery (default 1000, 0 = never)\n"
+        "  --metrics-csv FILE      Append one row of run metrics to FILE\n"
+        "  --label TEXT            Label stored in the metrics row\n"
+        "  --log                   Print the simulation event log to stderr (off by\n"
+        "                          default; no log lines are built without it)\n"
+        "  -q, --quiet             Only print errors\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+
+    std::string input;
+    std::string output;
+    std::string columnar;
+    std::string timeseries;
+    std::string trace;
+    int sampleEvery = 1;
+    long long timeseriesCapacity = 10000;
+    std::string metricsCsv;
+    std::string label;
+    long long maxTime = -1;
+    long long idleLimit = 1000;
+    bool streaming = false;
+    int reorderWindow = 0;
+    bool quiet = false;
+    bool log = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto next = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << "\n";
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+        if (arg == "-h" || arg == "--help") { printUsage(); return 0; }
+        else if (arg == "-o" || arg == "--output") output = next();
+        else if (arg == "--columnar") columnar = next();
+        else if (arg == "--timeseries") timeseries = next();
+        else if (arg == "--sample-every") sampleEvery = std::atoi(next().c_str());
+        else if (arg == "--timeseries-capacity") timeseriesCapacity = std::atoll(next().c_str());
+        else if (arg == "--trace") trace = next();
+        else if (arg == "--stream") streaming = true;
+        else if (arg == "--reorder-window") reorderWindow = std::atoi(next().c_str());
+        else if (arg == "--max-time") maxTime = std::atoll(next().c_str());
+        else if (arg == "--idle-limit") idleLimit = std::atoll(next().c_str());
+        else if (arg == "--metrics-csv") metricsCsv = next();
+        else if (arg == "--label") label = next();
+        else if (arg == "-q" || arg == "--quiet") quiet = true;
+        else if (arg == "--log") log = true;
+        else if (!arg.empty() && arg[0] != '-' && input.empty()) input = arg;
+        else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            printUsage();
+            return 2;
+        }
+    }
+
+    if (input.empty()) {
+        printUsage();
+        return 2;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    Simulator simulator;
+    if (log) {
+        QObject::connect(&simulator, &Simulator::logMessage, [](const LogRecord& record) {
+            std::cerr << formatLogRecord(record) << "\n";
+        });
+    } else {
+        simulator.setLogLevel(LogLevel::Off);
+    }
+
+    if (!trace.empty()) {
+        Tracer::start();
+        Tracer::setThreadName("simulation");
+    }
+
+    auto loadStart = Clock::now();
+    if (!simulator.loadFromFile(QString::fromStdString(input), streaming, reorderWindow)) {
+        std::cerr << "Failed to load " << input << ": " << simulator.getLoadError().toStdString() << "\n";
+        return 1;
+    }
+    double loadSeconds = std::chrono::duration<double>(Clock::now() - loadStart).count();
+
+    if (!timeseries.empty()) {
+        simulator.enableMetrics(static_cast<size_t>(std::max(timeseriesCapacity, 1LL)), sampleEvery);
+    }
+
+    // Deliveries go to the output file as they happen
+    if (!output.empty() && !simulator.openResultsStream(QString::fromStdString(output))) {
+        std::cerr << "Could not open " << output << " for writing\n";
+        return 1;
+    }
+    if (!columnar.empty() && !simulator.openColumnarResultsStream(QString::fromStdString(columnar))) {
+        std::cerr << "Could not open " << columnar << " for writing\n";
+        return 1;
+    }
+    
+    // Orders that no warehouse can ever fill would keep the run alive forever,
+    // so stop once the event queue is drained and nothing has moved for a while
+    auto runStart = Clock::now();
+    long long idleSteps = 0;
+    int lastDelivered = 0;
+    int lastWaiting = -1;
+    bool completed = false;
+    for (;;) {
+        simulator.step();
+        if (simulator.isFinished()) {
+            completed = true;
+            break;
+        }
+        if (maxTime >= 0 && simulator.getCurrentTime() >= maxTime) break;
+
+        if (idleLimit > 0 && !simulator.hasPendingEvents()) {
+            int delivered = simulator.getDeliveredCount();
+            int waiting = simulator.getWaitingOrderCount();
+            if (delivered == lastDelivered && waiting == lastWaiting) {
+                if (++idleSteps >= idleLimit) break;
+            } else {
+                idleSteps = 0;
+            }
+            lastDelivered = delivered;
+            lastWaiting = waiting;
+        }
+    }
+    double runSeconds = std::chrono::duration<double>(Clock::now() - runStart).count();
+    
+    std::string streamError = simulator.getStreamError().toStdString();
+    if (!streamError.empty()) {
+        std::cerr << "Error reading events: " << streamError << "\n";
+        return 1;
+    }
+    if (simulator.getLateEvents() > 0) {
+        std::cerr << "Warning: " << simulator.getLateEvents()
+                  << " events were out of order beyond the reorder window\n";
+    }
+
+    if (!output.empty() && !simulator.finishResultsStream()) {
+        std::cerr << "Failed to write " << output << "\n";
+        return 1;
+    }
+    if (!timeseries.empty() && !simulator.exportMetrics(QString::fromStdString(timeseries))) {
+        std::cerr << "Failed to write " << timeseries << "\n";
+        return 1;
+    }
+    std::string traceError;
+    if (!trace.empty() && !Tracer::stop(trace, traceError)) {
+        std::cerr << traceError << "\n";
+        return 1;
+    }
+    if (!columnar.empty() && !simulator.finishColumnarResultsStream()) {
+        std::cerr << "Failed to write " << columnar << "\n";
+        return 1;
+    }
+
+    Simulator::Statistics stats = simulator.getStatistics();
+    const Simulator::PhaseTimings& phases = simulator.getPhaseTimings();
+    long long events = simulator.getProcessedEvents();
+    long long simTime = simulator.getCurrentTime();
+    double eventsPerSecond = runSeconds > 0 ? events / runSeconds : 0;
+    double simUnitsPerSecond = runSeconds > 0 ? simTime / runSeconds : 0;
+    long long rssKb = peakRssKb();
+
+    if (!quiet) {
+        std::printf("Scenario:        %s\n", input.c_str());
+        std::printf("Result:          %s at T=%lld\n", completed ? "completed" : "stopped", simTime);
+        std::printf("Load time:       %.3f s\n", loadSeconds);
+        std::printf("Run time:        %.3f s (%lld steps)\n", runSeconds, phases.steps);
+        std::printf("Events/sec:      %.0f\n", eventsPerSecond);
+        std::printf("Sim units/sec:   %.0f\n", simUnitsPerSecond);
+        std::printf("Peak RSS:        %.1f MB\n", rssKb / 1024.0);
+        std::printf("\nPhase           total ms    ns/step\n");
+        auto phaseRow = [&](const char* name, long long ns) {
+            std::printf("%-14s %9.1f %10.0f\n", name, ns / 1e6,
+                        phases.steps > 0 ? static_cast<double>(ns) / phases.steps : 0.0);
+        };
+        phaseRow("events", phases.eventsNs);
+        phaseRow("arrivals", phases.arrivalsNs);
+        phaseRow("assignments", phases.assignmentsNs);
+        std::printf("\nOrders: %d total, %d delivered, %d canceled\n",
+                    stats.totalOrders, stats.deliveredOrders, stats.canceledOrders);
+        std::printf("Avg wait %.2f, avg transit %.2f, on-time %.1f%%\n",
+                    stats.avgWaitTime, stats.avgTransitTime, stats.onTimeRate);
+
+        // Why orders waited: every skipped attempt, and the last reason for
+        // orders still waiting at the end
+        const Scheduler::BlockedCounts& blocked = simulator.getBlockedTotals();
+        Scheduler::BlockedCounts stuck;
+        for (const auto& [oid, order] : simulator.getOrders()) {
+            if (order.getStatus() == OrderStatus::Waiting) stuck.add(order.getLastBlockReason());
+        }
+        std::printf("\nBlocked by        no stock  no vehicle   capacity\n");
+        std::printf("attempts      %12lld %11lld %10lld\n", blocked.noStock, blocked.noVehicle, blocked.noCapacity);
+        std::printf("still waiting %12lld %11lld %10lld\n", stuck.noStock, stuck.noVehicle, stuck.noCapacity);
+        std::printf("\nLatency              count      p50      p90      p99    p99.9\n");
+        for (int m = 0; m < LatencyStats::MetricCount; ++m) {
+            for (int c = 0; c < LatencyStats::ClassCount; ++c) {
+                const LatencyPercentiles& p = stats.latency.values[m][c];
+                std::string name = std::string(LatencyStats::metricName(m)) + " " + LatencyStats::className(c);
+                std::printf("%-19s %6lld %8d %8d %8d %8d\n", name.c_str(), p.count, p.p50, p.p90, p.p99, p.p999);
+            }
+        }
+        if (Profiler::kEnabled) {
+            // Inclusive times; the dispatch zones contain the find* lookups
+            std::printf("\nZone                       calls   total ms    ns/call\n");
+            for (int zone = 0; zone < Profiler::ZoneCount; ++zone) {
+                Profiler::ZoneStats z = Profiler::get(static_cast<Profiler::Zone>(zone));
+                std::printf("%-22s %11llu %10.1f %10.0f\n", Profiler::zoneName(zone),
+                            static_cast<unsigned long long>(z.calls), z.ns / 1e6,
+                            z.calls > 0 ? static_cast<double>(z.ns) / z.calls : 0.0);
+            }
+        }
+    }
+
+    if (!metricsCsv.empty()) {
+        bool writeHeader = !std::ifstream(metricsCsv).good();
+        std::ofstream csv(metricsCsv, std::ios::app);
+        if (!csv.is_open()) {
+            std::cerr << "Could not open " << metricsCsv << "\n";
+            return 1;
+        }
+        if (writeHeader) {
+            csv << "label,warehouses,vehicles,events,sim_time,steps,completed,load_s,run_s,"
+                   "events_per_s,sim_units_per_s,peak_rss_kb,events_ns,arrivals_ns,assignments_ns,"
+                   "orders,delivered\n";
+        }
+        csv << label << ","
+            << simulator.getWarehouses().size() << ","
+            << simulator.getVehicles().size() << ","
+            << events << ","
+            << simTime << ","
+            << phases.steps << ","
+            << (completed ? 1 : 0) << ","
+            << loadSeconds << ","
+            << runSeconds << ","
+            << eventsPerSecond << ","
+            << simUnitsPerSecond << ","
+            << rssKb << ","
+            << phases.eventsNs << ","
+            << phases.arrivalsNs << ","
+            << phases.assignmentsNs << ","
+            << stats.totalOrders << ","
+            << stats.deliveredOrders << "\n";
+    }
+
+    return 0;
+}
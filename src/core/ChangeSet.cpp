@@ -0,0 +1,52 @@
+#include "ChangeSet.h"
+#include <algorithm>
+
+namespace {
+template <typename T>
+void append(std::vector<T>& to, const std::vector<T>& from) {
+    to.insert(to.end(), from.begin(), from.end());
+}
+
+template <typename T>
+void sortUnique(std::vector<T>& values) {
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+}
+}
+
+bool ChangeSet::empty() const {
+    return !reset && orders.empty() && vehicles.empty() && stock.empty() &&
+           arrived.empty() && delivered.empty() && canceled.empty() &&
+           dispatched.empty() && restocked.empty();
+}
+
+void ChangeSet::clear() {
+    reset = false;
+    orders.clear();
+    vehicles.clear();
+    stock.clear();
+    arrived.clear();
+    delivered.clear();
+    canceled.clear();
+    dispatched.clear();
+    restocked.clear();
+}
+
+void ChangeSet::merge(const ChangeSet& other) {
+    time = other.time;
+    reset = reset || other.reset;
+    append(orders, other.orders);
+    append(vehicles, other.vehicles);
+    append(stock, other.stock);
+    append(arrived, other.arrived);
+    append(delivered, other.delivered);
+    append(canceled, other.canceled);
+    append(dispatched, other.dispatched);
+    append(restocked, other.restocked);
+}
+
+void ChangeSet::normalize() {
+    sortUnique(orders);
+    sortUnique(vehicles);
+    sortUnique(stock);
+}
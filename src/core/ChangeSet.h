@@ -0,0 +1,34 @@
+#ifndef CHANGESET_H
+#define CHANGESET_H
+
+#include <utility>
+#include <vector>
+
+// What changed in the simulation since the last change set, so consumers can
+// update in O(changes) instead of re-reading every map. The entity lists say
+// which orders, vehicles and warehouse stock to re-read; the event lists
+// carry what happened, in order. Ids may repeat until normalize().
+// A waiting order is listed each time the scheduler skips it.
+struct ChangeSet {
+    int time = 0;
+    bool reset = false;    // state was replaced (load/reset): re-read everything
+    
+    std::vector<int> orders;
+    std::vector<int> vehicles;
+    std::vector<std::pair<int, int>> stock;          // warehouse id, item id
+    
+    std::vector<int> arrived;                        // order ids
+    std::vector<int> delivered;
+    std::vector<int> canceled;
+    std::vector<std::pair<int, int>> dispatched;     // vehicle id, order id
+    std::vector<int> restocked;                      // warehouse ids
+    
+    bool empty() const;
+    void clear();
+    // Appends other, e.g. to fold several steps into one GUI frame
+    void merge(const ChangeSet& other);
+    // Sorts and deduplicates the entity lists
+    void normalize();
+};
+
+#endif // CHANGESET_H
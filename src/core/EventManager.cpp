@@ -1,36 +1,64 @@
 #include "EventManager.h"
+#include <algorithm>
 
-EventManager::EventManager() : m_totalEventsProcessed(0) {}
+EventManager::EventManager() : m_sequence(0), m_totalEventsProcessed(0) {}
 
 void EventManager::addEvent(EventPtr event) {
-    m_eventQueue.push(event);
+    m_eventQueue.push({std::move(event), m_sequence++});
+}
+
+void EventManager::setSource(std::shared_ptr<EventSource> source) {
+    m_source = std::move(source);
+    m_lookahead = m_source ? m_source->next() : nullptr;
+}
+
+void EventManager::advanceSource() {
+    m_lookahead = m_source->next();
+    if (!m_lookahead) m_source.reset();
 }
 
 EventPtr EventManager::getNextEvent() {
+    if (m_lookahead && (m_eventQueue.empty() ||
+                        m_lookahead->getTimestamp() < m_eventQueue.top().event->getTimestamp())) {
+        EventPtr event = m_lookahead;
+        advanceSource();
+        m_totalEventsProcessed++;
+        return event;
+    }
     if (m_eventQueue.empty()) return nullptr;
-    EventPtr event = m_eventQueue.top();
+    EventPtr event = m_eventQueue.top().event;
     m_eventQueue.pop();
     m_totalEventsProcessed++;
     return event;
 }
 
 bool EventManager::hasEventsAt(int timestamp) const {
+    if (m_lookahead && m_lookahead->getTimestamp() <= timestamp) return true;
     if (m_eventQueue.empty()) return false;
-    return m_eventQueue.top()->getTimestamp() == timestamp;
+    return m_eventQueue.top().event->getTimestamp() == timestamp;
 }
 
 int EventManager::getNextEventTime() const {
+    if (m_lookahead && (m_eventQueue.empty() ||
+                        m_lookahead->getTimestamp() < m_eventQueue.top().event->getTimestamp())) {
+        return m_lookahead->getTimestamp();
+    }
     if (m_eventQueue.empty()) return -1;
-    return m_eventQueue.top()->getTimestamp();
+    return m_eventQueue.top().event->getTimestamp();
 }
 
 std::vector<EventPtr> EventManager::getEventsAt(int timestamp) {
     std::vector<EventPtr> events;
-    while (!m_eventQueue.empty() && m_eventQueue.top()->getTimestamp() == timestamp) {
-        events.push_back(m_eventQueue.top());
+    while (!m_eventQueue.empty() && m_eventQueue.top().event->getTimestamp() == timestamp) {
+        events.push_back(m_eventQueue.top().event);
         m_eventQueue.pop();
         m_totalEventsProcessed++;
     }
+    while (m_lookahead && m_lookahead->getTimestamp() <= timestamp) {
+        events.push_back(m_lookahead);
+        advanceSource();
+        m_totalEventsProcessed++;
+    }
     return events;
 }
 
@@ -39,12 +67,22 @@ std::vector<EventPtr> EventManager::peekUpcoming(int count) const {
     // Create a copy of the queue to peek
     auto tempQueue = m_eventQueue;
     while (!tempQueue.empty() && upcoming.size() < static_cast<size_t>(count)) {
-        upcoming.push_back(tempQueue.top());
+        upcoming.push_back(tempQueue.top().event);
         tempQueue.pop();
     }
+    // Only the next streamed event is known without consuming the source
+    if (m_lookahead) {
+        upcoming.push_back(m_lookahead);
+        std::stable_sort(upcoming.begin(), upcoming.end(), [](const EventPtr& a, const EventPtr& b) {
+            return a->getTimestamp() < b->getTimestamp();
+        });
+        if (upcoming.size() > static_cast<size_t>(count)) upcoming.pop_back();
+    }
     return upcoming;
 }
 
 void EventManager::clear() {
     while (!m_eventQueue.empty()) m_eventQueue.pop();
+    m_source.reset();
+    m_lookahead.reset();
 }
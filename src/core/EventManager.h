@@ -13,7 +13,7 @@ public:
     void addEvent(EventPtr event);
     EventPtr getNextEvent();
     bool hasEventsAt(int timestamp) const;
-    bool hasEvents() const { return !m_eventQueue.empty(); }
+    bool hasEvents() const { return !m_eventQueue.empty() || m_lookahead; }
     int getNextEventTime() const;
     
     // Get all events at a specific timestamp
@@ -22,6 +22,11 @@ public:
     // Peek upcoming events without removing
     std::vector<EventPtr> peekUpcoming(int count) const;
     
+    // Streams further events from source instead of holding them all; they are
+    // merged after queued events with the same timestamp. Events the source
+    // delivers late (timestamp already passed) are released at the next call.
+    void setSource(std::shared_ptr<EventSource> source);
+    
     // Clear all events
     void clear();
     
@@ -29,7 +34,13 @@ public:
     int getTotalEvents() const { return m_totalEventsProcessed; }
     
 private:
-    std::priority_queue<EventPtr, std::vector<EventPtr>, EventComparator> m_eventQueue;
+    void advanceSource();
+    
+    // Events with the same timestamp come out in the order they were added
+    std::priority_queue<SequencedEvent, std::vector<SequencedEvent>, SequencedEventComparator> m_eventQueue;
+    long long m_sequence;
+    std::shared_ptr<EventSource> m_source;
+    EventPtr m_lookahead;
     int m_totalEventsProcessed;
 };
 
@@ -0,0 +1,114 @@
+#include "LatencyHistogram.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+int highestBit(uint32_t v) {
+    int bit = 0;
+    if (v >= 1u << 16) { v >>= 16; bit += 16; }
+    if (v >= 1u << 8) { v >>= 8; bit += 8; }
+    if (v >= 1u << 4) { v >>= 4; bit += 4; }
+    if (v >= 1u << 2) { v >>= 2; bit += 2; }
+    if (v >= 1u << 1) { bit += 1; }
+    return bit;
+}
+}
+
+void LatencyHistogram::clear() {
+    std::memset(m_counts, 0, sizeof(m_counts));
+    m_total = 0;
+}
+
+int LatencyHistogram::bucketOf(int value) {
+    if (value < kSubBuckets) return std::max(value, 0);
+    int msb = highestBit(static_cast<uint32_t>(value));
+    int shift = msb - kSubBucketBits;
+    return (shift + 1) * kSubBuckets + ((value >> shift) - kSubBuckets);
+}
+
+int LatencyHistogram::bucketUpperBound(int bucket) {
+    if (bucket < kSubBuckets) return bucket;
+    int shift = bucket / kSubBuckets - 1;
+    long long low = static_cast<long long>(bucket % kSubBuckets + kSubBuckets) << shift;
+    return static_cast<int>(std::min<long long>(low + (1LL << shift) - 1, 0x7FFFFFFF));
+}
+
+int LatencyHistogram::valueAtPercentile(double percentile) const {
+    int value = 0;
+    valuesAtPercentiles(&percentile, &value, 1);
+    return value;
+}
+
+void LatencyHistogram::valuesAtPercentiles(const double* percentiles, int* values, int n) const {
+    // One pass over the buckets; percentiles must be ascending
+    int next = 0;
+    uint64_t seen = 0;
+    for (int b = 0; b < kBuckets && next < n && m_total > 0; ++b) {
+        seen += m_counts[b];
+        while (next < n) {
+            uint64_t target = static_cast<uint64_t>(std::ceil(percentiles[next] / 100.0 * m_total));
+            if (seen < std::max<uint64_t>(target, 1)) break;
+            values[next++] = bucketUpperBound(b);
+        }
+    }
+    for (; next < n; ++next) values[next] = 0;
+}
+
+LatencyPercentiles LatencyHistogram::percentiles() const {
+    static const double kPercentiles[4] = {50, 90, 99, 99.9};
+    int values[4];
+    valuesAtPercentiles(kPercentiles, values, 4);
+
+    LatencyPercentiles p;
+    p.count = count();
+    p.p50 = values[0];
+    p.p90 = values[1];
+    p.p99 = values[2];
+    p.p999 = values[3];
+    return p;
+}
+
+void LatencyStats::apply(const Order& order, int sign) {
+    auto put = [sign](LatencyHistogram& histogram, int value) {
+        if (sign > 0) histogram.record(value);
+        else histogram.remove(value);
+    };
+    int cls = order.getPriorityClass() == PriorityClass::VIP ? Vip : Standard;
+    put(m_histograms[Wait][cls], order.getAssignTime() - order.getRequestTime());
+    put(m_histograms[Transit][cls], order.getFinishTime() - order.getDispatchTime());
+    put(m_histograms[EndToEnd][cls], order.getFinishTime() - order.getRequestTime());
+    if (order.getDueBy() != 0) {
+        put(m_histograms[Lateness][cls], std::max(order.getFinishTime() - order.getDueBy(), 0));
+    }
+}
+
+void LatencyStats::clear() {
+    for (auto& row : m_histograms) {
+        for (auto& histogram : row) histogram.clear();
+    }
+}
+
+LatencyStats::Summary LatencyStats::summary() const {
+    Summary s;
+    for (int m = 0; m < MetricCount; ++m) {
+        for (int c = 0; c < ClassCount; ++c) {
+            s.values[m][c] = m_histograms[m][c].percentiles();
+        }
+    }
+    return s;
+}
+
+const char* LatencyStats::metricName(int metric) {
+    switch (metric) {
+        case Wait: return "Wait";
+        case Transit: return "Transit";
+        case EndToEnd: return "End-to-End";
+        case Lateness: return "Lateness";
+    }
+    return "";
+}
+
+const char* LatencyStats::className(int cls) {
+    return cls == Vip ? "VIP" : "Standard";
+}
@@ -0,0 +1,79 @@
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <cstdint>
+#include "models/Order.h"
+
+struct LatencyPercentiles {
+    long long count = 0;
+    int p50 = 0;
+    int p90 = 0;
+    int p99 = 0;
+    int p999 = 0;
+};
+
+// Log-linear (HDR-style) histogram of non-negative integer durations. Values
+// below 64 are counted exactly; above that each power of two is split into 64
+// buckets, so reported percentiles are within 1/64 of the true value. The
+// bucket array has a fixed size covering the whole int range, so record() and
+// remove() are O(1) and never allocate.
+class LatencyHistogram {
+public:
+    static constexpr int kSubBucketBits = 6;
+    static constexpr int kSubBuckets = 1 << kSubBucketBits;
+    static constexpr int kBuckets = (31 - kSubBucketBits + 1) * kSubBuckets;
+
+    LatencyHistogram() { clear(); }
+
+    void record(int value) { m_counts[bucketOf(value)]++; m_total++; }
+
+    // Undoes an earlier record() of the same value
+    void remove(int value) { m_counts[bucketOf(value)]--; m_total--; }
+
+    void clear();
+    long long count() const { return static_cast<long long>(m_total); }
+
+    // Smallest value v such that at least percentile% of the samples are
+    // <= v, rounded up to the end of v's bucket. 0 when empty.
+    int valueAtPercentile(double percentile) const;
+    LatencyPercentiles percentiles() const;     // p50/p90/p99/p99.9 in one pass
+
+    static int bucketOf(int value);
+    static int bucketUpperBound(int bucket);
+
+private:
+    void valuesAtPercentiles(const double* percentiles, int* values, int n) const;
+
+    uint64_t m_counts[kBuckets];
+    uint64_t m_total;
+};
+
+// Delivered-order latencies, each split by priority class: wait (request to
+// assignment), transit (dispatch to delivery), end-to-end (request to
+// delivery) and lateness (time past dueBy, 0 when on time; only orders with a
+// due date).
+class LatencyStats {
+public:
+    enum Metric { Wait, Transit, EndToEnd, Lateness, MetricCount };
+    enum Class { Vip, Standard, ClassCount };
+
+    struct Summary {
+        LatencyPercentiles values[MetricCount][ClassCount];
+    };
+
+    void record(const Order& delivered) { apply(delivered, +1); }
+    void remove(const Order& delivered) { apply(delivered, -1); }
+    void clear();
+
+    Summary summary() const;
+
+    static const char* metricName(int metric);
+    static const char* className(int cls);
+
+private:
+    void apply(const Order& order, int sign);
+
+    LatencyHistogram m_histograms[MetricCount][ClassCount];
+};
+
+#endif // LATENCYHISTOGRAM_H
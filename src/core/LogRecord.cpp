@@ -0,0 +1,124 @@
+#include "LogRecord.h"
+
+LogRecord LogRecord::system(std::string text, int time) {
+    LogRecord record;
+    record.time = time;
+    record.text = std::move(text);
+    return record;
+}
+
+LogRecord LogRecord::arrival(int time, int orderId, int destination, bool vip) {
+    LogRecord record;
+    record.time = time;
+    record.type = LogType::Arrival;
+    record.orderId = orderId;
+    record.nodeA = destination;
+    record.vip = vip;
+    return record;
+}
+
+LogRecord LogRecord::manualArrival(int time, int orderId, bool vip) {
+    LogRecord record;
+    record.time = time;
+    record.type = LogType::Arrival;
+    record.orderId = orderId;
+    record.vip = vip;
+    record.manual = true;
+    return record;
+}
+
+LogRecord LogRecord::restock(int time, int warehouseId, int items) {
+    LogRecord record;
+    record.time = time;
+    record.type = LogType::Restock;
+    record.warehouseId = warehouseId;
+    record.amount = items;
+    return record;
+}
+
+LogRecord LogRecord::cancel(int time, int orderId) {
+    LogRecord record;
+    record.time = time;
+    record.type = LogType::Cancel;
+    record.orderId = orderId;
+    return record;
+}
+
+LogRecord LogRecord::maintenance(int time, int vehicleId, int duration) {
+    LogRecord record;
+    record.time = time;
+    record.type = LogType::Maintenance;
+    record.vehicleId = vehicleId;
+    record.amount = duration;
+    return record;
+}
+
+LogRecord LogRecord::reroute(int time, int nodeA, int nodeB, int travelTime) {
+    LogRecord record;
+    record.time = time;
+    record.type = LogType::Reroute;
+    record.nodeA = nodeA;
+    record.nodeB = nodeB;
+    record.amount = travelTime;
+    return record;
+}
+
+LogRecord LogRecord::dispatch(int time, int orderId, int vehicleId, int warehouseId) {
+    LogRecord record;
+    record.time = time;
+    record.type = LogType::Dispatch;
+    record.orderId = orderId;
+    record.vehicleId = vehicleId;
+    record.warehouseId = warehouseId;
+    return record;
+}
+
+LogRecord LogRecord::delivery(int time, int orderId, int vehicleId) {
+    LogRecord record;
+    record.time = time;
+    record.type = LogType::Delivery;
+    record.orderId = orderId;
+    record.vehicleId = vehicleId;
+    return record;
+}
+
+std::string formatLogRecord(const LogRecord& record) {
+    using std::to_string;
+    std::string line = record.time >= 0 ? "T=" + to_string(record.time) + ": " : std::string();
+
+    // Same wording as the events' getDescription()
+    switch (record.type) {
+        case LogType::System:
+            line += record.text;
+            break;
+        case LogType::Arrival:
+            if (record.manual) {
+                line += "Manual order #" + to_string(record.orderId) + " added (" + (record.vip ? "VIP" : "Standard") + ")";
+            } else {
+                line += "Order #" + to_string(record.orderId) + " arrived";
+                if (record.vip) line += " [VIP]";
+                line += " to dest " + to_string(record.nodeA);
+            }
+            break;
+        case LogType::Restock:
+            line += "Restock at Warehouse #" + to_string(record.warehouseId) + " (" + to_string(record.amount) + " items)";
+            break;
+        case LogType::Cancel:
+            line += "Order #" + to_string(record.orderId) + " canceled";
+            break;
+        case LogType::Maintenance:
+            line += "Vehicle #" + to_string(record.vehicleId) + " maintenance for " + to_string(record.amount) + " timesteps";
+            break;
+        case LogType::Reroute:
+            line += "Route " + to_string(record.nodeA) + "-" + to_string(record.nodeB) + " updated to " + to_string(record.amount) + " timesteps";
+            break;
+        case LogType::Dispatch:
+            line += "Order #" + to_string(record.orderId) + " dispatched via Vehicle #" + to_string(record.vehicleId)
+                  + " from Warehouse #" + to_string(record.warehouseId);
+            break;
+        case LogType::Delivery:
+            line += "Order #" + to_string(record.orderId) + " delivered";
+            break;
+    }
+    return line;
+}
@@ -0,0 +1,60 @@
+#ifndef LOGRECORD_H
+#define LOGRECORD_H
+
+#include <string>
+
+// What a simulator log line is about, so sinks can filter without parsing
+// the text. Ids are -1 when the line is not about an order or vehicle.
+enum class LogType { System, Arrival, Restock, Cancel, Maintenance, Reroute, Dispatch, Delivery };
+
+constexpr int kLogTypeCount = 8;
+
+inline const char* logTypeName(LogType type) {
+    switch (type) {
+        case LogType::System: return "System";
+        case LogType::Arrival: return "Arrival";
+        case LogType::Restock: return "Restock";
+        case LogType::Cancel: return "Cancel";
+        case LogType::Maintenance: return "Maintenance";
+        case LogType::Reroute: return "Reroute";
+        case LogType::Dispatch: return "Dispatch";
+        case LogType::Delivery: return "Delivery";
+    }
+    return "Unknown";
+}
+
+// Per-type threshold: a record is produced only if its level is at or
+// below the level set for its type. Off drops the type entirely.
+enum class LogLevel { Off, Warning, Info };
+
+// A log line as plain fields; the text is only built by formatLogRecord(),
+// i.e. when a sink actually shows the line. Which fields are set depends on
+// the type; only System records carry text of their own.
+struct LogRecord {
+    int time = -1;           // simulation time, -1 outside a run
+    LogType type = LogType::System;
+    int orderId = -1;
+    int vehicleId = -1;
+    int warehouseId = -1;
+    int nodeA = -1;          // arrival destination, reroute endpoints
+    int nodeB = -1;
+    int amount = 0;          // restocked items, maintenance duration, new travel time
+    bool vip = false;
+    bool manual = false;     // arrival entered in the GUI
+    std::string text;
+
+    static LogRecord system(std::string text, int time = -1);
+    static LogRecord arrival(int time, int orderId, int destination, bool vip);
+    static LogRecord manualArrival(int time, int orderId, bool vip);
+    static LogRecord restock(int time, int warehouseId, int items);
+    static LogRecord cancel(int time, int orderId);
+    static LogRecord maintenance(int time, int vehicleId, int duration);
+    static LogRecord reroute(int time, int nodeA, int nodeB, int travelTime);
+    static LogRecord dispatch(int time, int orderId, int vehicleId, int warehouseId);
+    static LogRecord delivery(int time, int orderId, int vehicleId);
+};
+
+// "T=<time>: <description>", or just the description outside a run
+std::string formatLogRecord(const LogRecord& record);
+
+#endif // LOGRECORD_H
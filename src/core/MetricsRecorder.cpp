@@ -0,0 +1,111 @@
+#include "MetricsRecorder.h"
+#include <algorithm>
+#include <cstdio>
+#include "io/ColumnarWriter.h"
+
+MetricsRecorder::MetricsRecorder()
+    : m_capacity(0), m_interval(1), m_head(0), m_size(0), m_overwritten(0) {}
+
+void MetricsRecorder::configure(size_t capacity, int interval, const std::map<int, Warehouse>& warehouses) {
+    m_capacity = capacity;
+    m_interval = std::max(interval, 1);
+    m_warehouses.clear();
+    m_warehouseIds.clear();
+    for (const auto& [wid, warehouse] : warehouses) {
+        m_warehouses.push_back(&warehouse);
+        m_warehouseIds.push_back(wid);
+    }
+    for (auto& column : m_columns) column.assign(capacity, 0);
+    m_inventory.assign(capacity * m_warehouses.size(), 0);
+    clear();
+}
+
+void MetricsRecorder::clear() {
+    m_head = 0;
+    m_size = 0;
+    m_overwritten = 0;
+}
+
+void MetricsRecorder::record(const int (&values)[ColumnCount]) {
+    if (m_capacity == 0) return;
+    for (int c = 0; c < ColumnCount; ++c) m_columns[c][m_head] = values[c];
+
+    int* row = m_inventory.data() + m_head * m_warehouses.size();
+    for (const Warehouse* warehouse : m_warehouses) *row++ = warehouse->getTotalItems();
+
+    m_head = (m_head + 1) % m_capacity;
+    if (m_size < m_capacity) m_size++;
+    else m_overwritten++;
+}
+
+bool MetricsRecorder::exportCsv(const std::string& filename) const {
+    std::FILE* file = std::fopen(filename.c_str(), "w");
+    if (!file) {
+        m_error = "Could not open file for writing: " + filename;
+        return false;
+    }
+
+    for (int c = 0; c < ColumnCount; ++c) std::fprintf(file, c ? ",%s" : "%s", columnName(c));
+    for (int wid : m_warehouseIds) std::fprintf(file, ",inventory_w%d", wid);
+    std::fputc('\n', file);
+
+    for (size_t i = 0; i < m_size; ++i) {
+        for (int c = 0; c < ColumnCount; ++c) {
+            std::fprintf(file, c ? ",%d" : "%d", value(i, static_cast<Column>(c)));
+        }
+        for (size_t w = 0; w < m_warehouses.size(); ++w) std::fprintf(file, ",%d", inventory(i, w));
+        std::fputc('\n', file);
+    }
+
+    bool ok = std::ferror(file) == 0;
+    ok = (std::fclose(file) == 0) && ok;
+    if (!ok) m_error = "Write error while saving " + filename;
+    return ok;
+}
+
+bool MetricsRecorder::exportArrow(const std::string& filename) const {
+    std::vector<ArrowFileWriter::Column> schema;
+    for (int c = 0; c < ColumnCount; ++c) schema.push_back({columnName(c), ArrowFileWriter::ColumnType::Int32});
+    for (int wid : m_warehouseIds) {
+        schema.push_back({"inventory_w" + std::to_string(wid), ArrowFileWriter::ColumnType::Int32});
+    }
+
+    // Unroll the ring oldest-first, one contiguous array per column
+    size_t columns = schema.size();
+    std::vector<int> data(columns * m_size);
+    for (size_t i = 0; i < m_size; ++i) {
+        for (int c = 0; c < ColumnCount; ++c) data[c * m_size + i] = value(i, static_cast<Column>(c));
+        for (size_t w = 0; w < m_warehouses.size(); ++w) data[(ColumnCount + w) * m_size + i] = inventory(i, w);
+    }
+    std::vector<const void*> pointers;
+    for (size_t c = 0; c < columns; ++c) pointers.push_back(data.data() + c * m_size);
+
+    ArrowFileWriter writer;
+    if (!writer.open(filename, schema)) {
+        m_error = writer.getError();
+        return false;
+    }
+    bool ok = writer.writeBatch(m_size, pointers);
+    if (!writer.close() || !ok) {
+        m_error = writer.getError().empty() ? "Write error while saving " + filename : writer.getError();
+        return false;
+    }
+    return true;
+}
+
+const char* MetricsRecorder::columnName(int column) {
+    switch (column) {
+        case Time: return "time";
+        case VipQueue: return "vip_queue";
+        case StdQueue: return "std_queue";
+        case VehiclesAvailable: return "vehicles_available";
+        case VehiclesOutbound: return "vehicles_outbound";
+        case VehiclesReturning: return "vehicles_returning";
+        case VehiclesMaintenance: return "vehicles_maintenance";
+        case InTransit: return "in_transit";
+        case BlockedNoStock: return "blocked_no_stock";
+        case BlockedNoVehicle: return "blocked_no_vehicle";
+        case BlockedNoCapacity: return "blocked_no_capacity";
+    }
+    return "";
+}
@@ -0,0 +1,68 @@
+#ifndef METRICSRECORDER_H
+#define METRICSRECORDER_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include "models/Warehouse.h"
+
+// Time series of simulation state, sampled every Nth step into a fixed-size
+// ring buffer. Storage is columnar and allocated once by configure(); when
+// full, the oldest samples are overwritten. Recording a sample is a handful
+// of stores plus one per warehouse.
+class MetricsRecorder {
+public:
+    enum Column {
+        Time, VipQueue, StdQueue,
+        VehiclesAvailable, VehiclesOutbound, VehiclesReturning, VehiclesMaintenance,
+        InTransit, BlockedNoStock, BlockedNoVehicle, BlockedNoCapacity,
+        ColumnCount
+    };
+
+    MetricsRecorder();
+
+    // capacity 0 disables recording. The warehouse set is fixed from here on;
+    // warehouses added later are not sampled.
+    void configure(size_t capacity, int interval, const std::map<int, Warehouse>& warehouses);
+    void clear();
+
+    bool isEnabled() const { return m_capacity > 0; }
+    bool isDue(long long step) const { return m_capacity > 0 && step % m_interval == 0; }
+
+    // values[c] for every Column; inventory totals are read from the warehouses
+    void record(const int (&values)[ColumnCount]);
+
+    size_t size() const { return m_size; }
+    size_t capacity() const { return m_capacity; }
+    int interval() const { return m_interval; }
+    long long getOverwritten() const { return m_overwritten; }
+
+    // i = 0 is the oldest sample still held
+    int value(size_t i, Column column) const { return m_columns[column][slot(i)]; }
+    int inventory(size_t i, size_t warehouse) const { return m_inventory[slot(i) * m_warehouses.size() + warehouse]; }
+    const std::vector<int>& getWarehouseIds() const { return m_warehouseIds; }
+
+    // CSV with a header row, or an Arrow file (see ArrowFileWriter)
+    bool exportCsv(const std::string& filename) const;
+    bool exportArrow(const std::string& filename) const;
+
+    std::string getError() const { return m_error; }
+
+    static const char* columnName(int column);
+
+private:
+    size_t slot(size_t i) const { return (m_head + m_capacity - m_size + i) % m_capacity; }
+
+    size_t m_capacity;
+    int m_interval;
+    size_t m_head;          // next slot to write
+    size_t m_size;
+    long long m_overwritten;
+    std::vector<int> m_columns[ColumnCount];
+    std::vector<int> m_inventory;    // capacity x warehouses, row per sample
+    std::vector<const Warehouse*> m_warehouses;
+    std::vector<int> m_warehouseIds;
+    mutable std::string m_error;
+};
+
+#endif // METRICSRECORDER_H
@@ -0,0 +1,169 @@
+#include "NetworkLayout.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+
+namespace {
+using Point = std::pair<double, double>;
+
+const int kNearest = 12;          // springs to the closest nodes by travel time
+const int kFar = 8;               // plus a fixed sample of arbitrary nodes for the global shape
+const int kIterations = 120;
+const size_t kParallelNodes = 1000;
+
+struct Spring {
+    int node;
+    double length;
+    double weight;
+};
+
+uint64_t mix(uint64_t x) {
+    // splitmix64 finalizer; keeps the far sample independent of thread count
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// Symmetric, strictly positive target distance between two nodes
+double targetLength(const std::vector<std::vector<int>>& t, int i, int j) {
+    int ij = j < static_cast<int>(t[i].size()) ? t[i][j] : 0;
+    int ji = i < static_cast<int>(t[j].size()) ? t[j][i] : 0;
+    return std::max(1.0, 0.5 * (ij + ji));
+}
+
+// Runs fn(begin, end) over [0, count) split across threads
+template <typename Fn>
+void parallelFor(size_t count, unsigned threads, Fn fn) {
+    if (threads <= 1 || count < kParallelNodes) {
+        fn(size_t(0), count);
+        return;
+    }
+    size_t chunk = (count + threads - 1) / threads;
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads && t * chunk < count; ++t) {
+        pool.emplace_back(fn, t * chunk, std::min(count, (t + 1) * chunk));
+    }
+    fn(size_t(0), std::min(count, chunk));
+    for (std::thread& t : pool) t.join();
+}
+}
+
+namespace NetworkLayout {
+
+std::vector<Point> compute(const std::vector<std::vector<int>>& travelTimes, unsigned threads) {
+    std::vector<Point> result(travelTimes.size(), {0.5, 0.5});
+    int n = static_cast<int>(travelTimes.size()) - 1;
+    if (n <= 1) return result;
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+
+    // Springs per node (index 0 is node 1). Small networks keep every pair.
+    std::vector<std::vector<Spring>> springs(n);
+    bool allPairs = n <= kNearest + kFar + 1;
+    parallelFor(static_cast<size_t>(n), threads, [&](size_t begin, size_t end) {
+        std::vector<std::pair<double, int>> byLength;
+        for (size_t k = begin; k < end; ++k) {
+            int i = static_cast<int>(k) + 1;
+            byLength.clear();
+            for (int j = 1; j <= n; ++j) {
+                if (j != i) byLength.push_back({targetLength(travelTimes, i, j), j});
+            }
+
+            size_t nearest = allPairs ? byLength.size() : static_cast<size_t>(kNearest);
+            std::nth_element(byLength.begin(), byLength.begin() + (nearest - 1), byLength.end());
+            std::vector<Spring>& own = springs[k];
+            for (size_t s = 0; s < nearest; ++s) {
+                double d = byLength[s].first;
+                own.push_back({byLength[s].second, d, 1.0 / (d * d)});
+            }
+            // The far sample comes from the rest, in a fixed pseudo-random order
+            for (int s = 0; s < kFar && !allPairs; ++s) {
+                size_t pick = nearest + mix(static_cast<uint64_t>(i) * kFar + s) % (byLength.size() - nearest);
+                double d = byLength[pick].first;
+                own.push_back({byLength[pick].second, d, 1.0 / (d * d)});
+            }
+        }
+    });
+
+    // Start from FastMap: two pivot pairs that lie far apart give each node
+    // an x and a y from its travel times to them. Springs then only have to
+    // fix local distortion instead of untangling a random scatter.
+    std::vector<Point> pos(n + 1), next(n + 1);
+    auto length = [&](int i, int j) { return i == j ? 0.0 : targetLength(travelTimes, i, j); };
+    auto farthest = [&](int from, auto&& dist) {
+        int best = from;
+        double bestDist = -1;
+        for (int j = 1; j <= n; ++j) {
+            double d = dist(from, j);
+            if (d > bestDist) {
+                bestDist = d;
+                best = j;
+            }
+        }
+        return best;
+    };
+    auto project = [&](int a, int b, auto&& dist2, double Point::*axis) {
+        double ab2 = dist2(a, b);
+        double ab = std::sqrt(ab2);
+        for (int i = 1; i <= n; ++i) {
+            pos[i].*axis = ab > 0 ? (dist2(a, i) + ab2 - dist2(b, i)) / (2 * ab) : 0.0;
+        }
+    };
+    auto dist2x = [&](int i, int j) { return length(i, j) * length(i, j); };
+    int b = farthest(1, length);
+    int a = farthest(b, length);
+    project(a, b, dist2x, &Point::first);
+    // What x leaves unexplained
+    auto dist2y = [&](int i, int j) {
+        double dx = pos[i].first - pos[j].first;
+        return std::max(0.0, dist2x(i, j) - dx * dx);
+    };
+    int d = farthest(a, dist2y);
+    int c = farthest(d, dist2y);
+    project(c, d, dist2y, &Point::second);
+
+    // Each node moves to where its springs agree, given the others' last
+    // positions (Jacobi), so the update splits cleanly across threads
+    for (int iter = 0; iter < kIterations; ++iter) {
+        parallelFor(static_cast<size_t>(n), threads, [&](size_t begin, size_t end) {
+            for (size_t k = begin; k < end; ++k) {
+                int i = static_cast<int>(k) + 1;
+                double x = 0, y = 0, total = 0;
+                for (const Spring& s : springs[k]) {
+                    double dx = pos[i].first - pos[s.node].first;
+                    double dy = pos[i].second - pos[s.node].second;
+                    double dist = std::sqrt(dx * dx + dy * dy);
+                    if (dist < 1e-9) {
+                        // Coincident: separate along a direction fixed by the pair
+                        double angle = static_cast<double>(mix(static_cast<uint64_t>(i) * 131 + s.node) % 6283) / 1000.0;
+                        dx = std::cos(angle);
+                        dy = std::sin(angle);
+                        dist = 1.0;
+                    }
+                    x += s.weight * (pos[s.node].first + s.length * dx / dist);
+                    y += s.weight * (pos[s.node].second + s.length * dy / dist);
+                    total += s.weight;
+                }
+                next[i] = {x / total, y / total};
+            }
+        });
+        pos.swap(next);
+    }
+
+    // Fit into the unit square, keeping the aspect ratio
+    double minX = pos[1].first, maxX = minX, minY = pos[1].second, maxY = minY;
+    for (int i = 2; i <= n; ++i) {
+        minX = std::min(minX, pos[i].first);
+        maxX = std::max(maxX, pos[i].first);
+        minY = std::min(minY, pos[i].second);
+        maxY = std::max(maxY, pos[i].second);
+    }
+    double extent = std::max({maxX - minX, maxY - minY, 1e-9});
+    for (int i = 1; i <= n; ++i) {
+        result[i] = {(pos[i].first - minX) / extent, (pos[i].second - minY) / extent};
+    }
+    return result;
+}
+
+}
@@ -0,0 +1,23 @@
+#ifndef NETWORKLAYOUT_H
+#define NETWORKLAYOUT_H
+
+#include <utility>
+#include <vector>
+
+// Places the nodes of a travel-time matrix in the plane so that straight-line
+// distances follow travel times, for drawing scenarios that carry no node
+// coordinates. Spring model (localized stress majorization): every node is
+// pulled towards the distance its nearest neighbours and a fixed random
+// sample of far nodes ask for, so an iteration is O(W) rather than O(W^2).
+// Deterministic for a given matrix, whatever the thread count.
+namespace NetworkLayout {
+
+// travelTimes is the 1-based (W+1)^2 matrix; the result holds (x, y) for
+// nodes 1..W, scaled into the unit square (index 0 unused). threads = 0
+// uses every hardware thread.
+std::vector<std::pair<double, double>> compute(const std::vector<std::vector<int>>& travelTimes,
+                                               unsigned threads = 0);
+
+}
+
+#endif // NETWORKLAYOUT_H
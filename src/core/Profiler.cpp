@@ -0,0 +1,69 @@
+#include "Profiler.h"
+#include <atomic>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+struct Counters {
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> ticks{0};
+};
+
+Counters g_zones[Profiler::ZoneCount];
+
+// Reference point for converting ticks to nanoseconds
+const uint64_t g_startTicks = Profiler::ticks();
+const Clock::time_point g_startTime = Clock::now();
+
+double nsPerTick() {
+#ifdef WDS_PROFILE_TSC
+    uint64_t elapsedTicks = Profiler::ticks() - g_startTicks;
+    auto elapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - g_startTime).count();
+    return elapsedTicks > 0 ? static_cast<double>(elapsedNs) / elapsedTicks : 0.0;
+#else
+    return 1.0;
+#endif
+}
+}
+
+namespace Profiler {
+
+const char* zoneName(int zone) {
+    switch (zone) {
+        case ProcessEvents: return "processEvents";
+        case OrderArrival: return "order arrival";
+        case Restock: return "restock";
+        case Cancel: return "cancel";
+        case Maintenance: return "maintenance";
+        case Reroute: return "reroute";
+        case VehicleArrivals: return "processVehicleArrivals";
+        case VipSort: return "VIP sort";
+        case VipDispatch: return "VIP dispatch";
+        case StdDispatch: return "standard dispatch";
+        case FindBestWarehouse: return "findBestWarehouse";
+        case FindBestVehicle: return "findBestVehicle";
+        case GuiRefresh: return "GUI refresh";
+    }
+    return "";
+}
+
+ZoneStats get(Zone zone) {
+    ZoneStats s;
+    s.calls = g_zones[zone].calls.load(std::memory_order_relaxed);
+    s.ns = static_cast<uint64_t>(g_zones[zone].ticks.load(std::memory_order_relaxed) * nsPerTick());
+    return s;
+}
+
+void reset() {
+    for (auto& zone : g_zones) {
+        zone.calls.store(0, std::memory_order_relaxed);
+        zone.ticks.store(0, std::memory_order_relaxed);
+    }
+}
+
+void add(Zone zone, uint64_t ticks) {
+    g_zones[zone].calls.fetch_add(1, std::memory_order_relaxed);
+    g_zones[zone].ticks.fetch_add(ticks, std::memory_order_relaxed);
+}
+
+} // namespace Profiler
@@ -0,0 +1,93 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define WDS_PROFILE_TSC 1
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define WDS_PROFILE_TSC 1
+#endif
+
+// Scoped hot-path timers. WDS_PROFILE_SCOPE(zone) adds the time until the end
+// of the enclosing scope to that zone's call count and nanoseconds. Zones
+// nest, so times are inclusive (VIP dispatch includes the findBestWarehouse
+// calls it makes). Timestamps come from the TSC on x86 (about half the cost
+// of steady_clock) and are converted to nanoseconds against steady_clock when
+// read. Without WDS_PROFILING (CMake option of the same name) the macro
+// expands to nothing and the counters stay at zero.
+namespace Profiler {
+
+enum Zone {
+    ProcessEvents,
+    OrderArrival,
+    Restock,
+    Cancel,
+    Maintenance,
+    Reroute,
+    VehicleArrivals,
+    VipSort,
+    VipDispatch,
+    StdDispatch,
+    FindBestWarehouse,
+    FindBestVehicle,
+    GuiRefresh,
+    ZoneCount
+};
+
+struct ZoneStats {
+    uint64_t calls = 0;
+    uint64_t ns = 0;
+};
+
+#ifdef WDS_PROFILING
+constexpr bool kEnabled = true;
+#else
+constexpr bool kEnabled = false;
+#endif
+
+const char* zoneName(int zone);
+ZoneStats get(Zone zone);
+void reset();
+
+inline uint64_t ticks() {
+#ifdef WDS_PROFILE_TSC
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// Relaxed atomics: zones may be timed from more than one thread
+void add(Zone zone, uint64_t ticks);
+
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Zone zone) : m_zone(zone), m_start(ticks()) {}
+    ~ScopedTimer() { add(m_zone, ticks() - m_start); }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Zone m_zone;
+    uint64_t m_start;
+};
+
+} // namespace Profiler
+
+#define WDS_PROFILE_CONCAT_(a, b) a##b
+#define WDS_PROFILE_CONCAT(a, b) WDS_PROFILE_CONCAT_(a, b)
+
+#ifdef WDS_PROFILING
+#define WDS_PROFILE_SCOPE(zone) \
+    Profiler::ScopedTimer WDS_PROFILE_CONCAT(wdsProfileTimer, __LINE__)(Profiler::zone)
+#else
+#define WDS_PROFILE_SCOPE(zone) do {} while (0)
+#endif
+
+#endif // PROFILER_H
@@ -1,10 +1,13 @@
 #include "Scheduler.h"
+#include "Profiler.h"
 #include <algorithm>
+#include <iterator>
 #include <limits>
 
 Scheduler::Scheduler() 
     : m_orders(nullptr), m_warehouses(nullptr), 
-      m_vehicles(nullptr), m_travelTimes(nullptr) {}
+      m_vehicles(nullptr), m_travelTimes(nullptr), m_changes(nullptr),
+      m_vehicleCounts{0, 0, 0, 0}, m_inTransit(0) {}
 
 void Scheduler::setData(std::map<int, Order>* orders,
                         std::map<int, Warehouse>* warehouses,
@@ -14,6 +17,33 @@ void Scheduler::setData(std::map<int, Order>* orders,
     m_warehouses = warehouses;
     m_vehicles = vehicles;
     m_travelTimes = travelTimes;
+    recount();
+}
+
+void Scheduler::setVehicleStatus(Vehicle& vehicle, VehicleStatus status) {
+    m_vehicleCounts[static_cast<int>(vehicle.getStatus())]--;
+    m_vehicleCounts[static_cast<int>(status)]++;
+    vehicle.setStatus(status);
+    if (m_changes) m_changes->vehicles.push_back(vehicle.getId());
+}
+
+void Scheduler::recount() {
+    std::fill(std::begin(m_vehicleCounts), std::end(m_vehicleCounts), 0);
+    m_inTransit = 0;
+    if (!m_vehicles) return;
+    for (const auto& [vid, vehicle] : *m_vehicles) {
+        m_vehicleCounts[static_cast<int>(vehicle.getStatus())]++;
+        m_inTransit += vehicle.getOrderCount();
+    }
+}
+
+void Scheduler::BlockedCounts::add(BlockReason reason) {
+    switch (reason) {
+        case BlockReason::NoStock: noStock++; break;
+        case BlockReason::NoVehicle: noVehicle++; break;
+        case BlockReason::NoCapacity: noCapacity++; break;
+        default: break;
+    }
 }
 
 void Scheduler::addVipOrder(int orderId) {
@@ -31,23 +61,42 @@ void Scheduler::removeFromQueues(int orderId) {
 
 std::vector<Scheduler::AssignmentResult> Scheduler::attemptAssignments(int currentTime) {
     std::vector<AssignmentResult> results;
+    m_lastBlocked = BlockedCounts();
     
     // Sort VIP queue by priority
-    std::sort(m_vipQueue.begin(), m_vipQueue.end(), 
-        [this, currentTime](int a, int b) {
-            return m_orders->at(a).calculatePriority(currentTime) > 
-                   m_orders->at(b).calculatePriority(currentTime);
-        });
+    {
+        WDS_PROFILE_SCOPE(VipSort);
+        std::sort(m_vipQueue.begin(), m_vipQueue.end(), 
+            [this, currentTime](int a, int b) {
+                return m_orders->at(a).calculatePriority(currentTime) > 
+                       m_orders->at(b).calculatePriority(currentTime);
+            });
+    }
+    
+    auto block = [&](Order& order, BlockReason reason) {
+        // Listed on every block: the counts shown per order change too
+        if (m_changes) m_changes->orders.push_back(order.getId());
+        order.recordBlock(reason);
+        m_lastBlocked.add(reason);
+        m_blockedTotals.add(reason);
+    };
     
     auto tryAssign = [&](int orderId) -> bool {
         Order& order = m_orders->at(orderId);
         if (order.getStatus() != OrderStatus::Waiting) return false;
         
         int warehouseId = findBestWarehouse(order);
-        if (warehouseId == -1) return false;
+        if (warehouseId == -1) {
+            block(order, BlockReason::NoStock);
+            return false;
+        }
         
-        int vehicleId = findBestVehicle(warehouseId, order);
-        if (vehicleId == -1) return false;
+        BlockReason reason = BlockReason::NoVehicle;
+        int vehicleId = findBestVehicle(warehouseId, order, &reason);
+        if (vehicleId == -1) {
+            block(order, reason);
+            return false;
+        }
         
         // Perform assignment
         Warehouse& warehouse = m_warehouses->at(warehouseId);
@@ -56,17 +105,20 @@ std::vector<Scheduler::AssignmentResult> Scheduler::attemptAssignments(int curre
         // Deduct inventory
         for (const auto& item : order.getDemand()) {
             warehouse.removeInventory(item.first, item.second);
+            if (m_changes) m_changes->stock.push_back({warehouseId, item.first});
         }
         
         // Update order
         order.setStatus(OrderStatus::InTransit);
+        m_inTransit++;
+        if (m_changes) m_changes->orders.push_back(orderId);
         order.setAssignedWarehouse(warehouseId);
         order.setAssignedVehicle(vehicleId);
         order.setAssignTime(currentTime);
         order.setDispatchTime(currentTime);
         
         // Update vehicle
-        vehicle.setStatus(VehicleStatus::Outbound);
+        setVehicleStatus(vehicle, VehicleStatus::Outbound);
         vehicle.setCurrentDestination(order.getDestination());
         vehicle.assignOrder(orderId);
         
@@ -85,24 +137,30 @@ std::vector<Scheduler::AssignmentResult> Scheduler::attemptAssignments(int curre
     };
     
     // Try VIP orders first
-    for (auto it = m_vipQueue.begin(); it != m_vipQueue.end();) {
-        if (m_orders->at(*it).getStatus() != OrderStatus::Waiting) {
-            it = m_vipQueue.erase(it);
-        } else if (tryAssign(*it)) {
-            it = m_vipQueue.erase(it);
-        } else {
-            ++it;
+    {
+        WDS_PROFILE_SCOPE(VipDispatch);
+        for (auto it = m_vipQueue.begin(); it != m_vipQueue.end();) {
+            if (m_orders->at(*it).getStatus() != OrderStatus::Waiting) {
+                it = m_vipQueue.erase(it);
+            } else if (tryAssign(*it)) {
+                it = m_vipQueue.erase(it);
+            } else {
+                ++it;
+            }
         }
     }
     
     // Then standard orders
-    for (auto it = m_stdQueue.begin(); it != m_stdQueue.end();) {
-        if (m_orders->at(*it).getStatus() != OrderStatus::Waiting) {
-            it = m_stdQueue.erase(it);
-        } else if (tryAssign(*it)) {
-            it = m_stdQueue.erase(it);
-        } else {
-            ++it;
+    {
+        WDS_PROFILE_SCOPE(StdDispatch);
+        for (auto it = m_stdQueue.begin(); it != m_stdQueue.end();) {
+            if (m_orders->at(*it).getStatus() != OrderStatus::Waiting) {
+                it = m_stdQueue.erase(it);
+            } else if (tryAssign(*it)) {
+                it = m_stdQueue.erase(it);
+            } else {
+                ++it;
+            }
         }
     }
     
@@ -110,6 +168,7 @@ std::vector<Scheduler::AssignmentResult> Scheduler::attemptAssignments(int curre
 }
 
 std::vector<Scheduler::DeliveryResult> Scheduler::processVehicleArrivals(int currentTime) {
+    WDS_PROFILE_SCOPE(VehicleArrivals);
     std::vector<DeliveryResult> results;
     
     for (auto& [vid, vehicle] : *m_vehicles) {
@@ -118,8 +177,10 @@ std::vector<Scheduler::DeliveryResult> Scheduler::processVehicleArrivals(int cur
                 // Vehicle arrived at destination - deliver orders
                 for (int orderId : vehicle.getAssignedOrders()) {
                     Order& order = m_orders->at(orderId);
+                    m_inTransit--;
                     order.setStatus(OrderStatus::Delivered);
                     order.setFinishTime(currentTime);
+                    if (m_changes) m_changes->orders.push_back(orderId);
                     
                     DeliveryResult result;
                     result.orderId = orderId;
@@ -128,7 +189,7 @@ std::vector<Scheduler::DeliveryResult> Scheduler::processVehicleArrivals(int cur
                 }
                 
                 vehicle.clearOrders();
-                vehicle.setStatus(VehicleStatus::Returning);
+                setVehicleStatus(vehicle, VehicleStatus::Returning);
                 
                 // Calculate return time
                 int returnTime = getTravelTime(vehicle.getCurrentDestination(), 
@@ -138,7 +199,7 @@ std::vector<Scheduler::DeliveryResult> Scheduler::processVehicleArrivals(int cur
             } else if (vehicle.getStatus() == VehicleStatus::Returning ||
                        vehicle.getStatus() == VehicleStatus::Maintenance) {
                 // Vehicle is back home or maintenance complete
-                vehicle.setStatus(VehicleStatus::Available);
+                setVehicleStatus(vehicle, VehicleStatus::Available);
             }
         }
     }
@@ -147,6 +208,7 @@ std::vector<Scheduler::DeliveryResult> Scheduler::processVehicleArrivals(int cur
 }
 
 int Scheduler::findBestWarehouse(const Order& order) const {
+    WDS_PROFILE_SCOPE(FindBestWarehouse);
     int bestWarehouse = -1;
     int minDistance = std::numeric_limits<int>::max();
     
@@ -163,14 +225,20 @@ int Scheduler::findBestWarehouse(const Order& order) const {
     return bestWarehouse;
 }
 
-int Scheduler::findBestVehicle(int warehouseId, const Order& order) const {
+int Scheduler::findBestVehicle(int warehouseId, const Order& order, BlockReason* reason) const {
+    WDS_PROFILE_SCOPE(FindBestVehicle);
     int bestVehicle = -1;
     int earliestAvailable = std::numeric_limits<int>::max();
+    int quantity = order.getTotalQuantity();
+    bool tooSmall = false;
     
     for (const auto& [vid, vehicle] : *m_vehicles) {
         if (vehicle.getHomeWarehouse() == warehouseId &&
-            vehicle.getStatus() == VehicleStatus::Available &&
-            vehicle.canCarry(order.getTotalQuantity())) {
+            vehicle.getStatus() == VehicleStatus::Available) {
+            if (!vehicle.canCarry(quantity)) {
+                tooSmall = true;
+                continue;
+            }
             
             if (vehicle.getAvailableTime() < earliestAvailable) {
                 earliestAvailable = vehicle.getAvailableTime();
@@ -179,6 +247,9 @@ int Scheduler::findBestVehicle(int warehouseId, const Order& order) const {
         }
     }
     
+    if (bestVehicle == -1 && reason) {
+        *reason = tooSmall ? BlockReason::NoCapacity : BlockReason::NoVehicle;
+    }
     return bestVehicle;
 }
 
@@ -5,6 +5,7 @@
 #include <queue>
 #include <map>
 #include <functional>
+#include "ChangeSet.h"
 #include "models/Order.h"
 #include "models/Warehouse.h"
 #include "models/Vehicle.h"
@@ -19,6 +20,10 @@ public:
                  std::map<int, Vehicle>* vehicles,
                  std::vector<std::vector<int>>* travelTimes);
     
+    // Orders, vehicles and stock the scheduler changes are appended here
+    // (nullptr to not record them)
+    void setChangeSet(ChangeSet* changes) { m_changes = changes; }
+    
     // Order queue management
     void addVipOrder(int orderId);
     void addStandardOrder(int orderId);
@@ -50,13 +55,37 @@ public:
     // Check if any orders are waiting
     bool hasWaitingOrders() const { return !m_vipQueue.empty() || !m_stdQueue.empty(); }
     
-private:
+    // Fleet and order counts, maintained as vehicles and orders change state.
+    // Vehicle status changes made outside the scheduler must go through
+    // setVehicleStatus(); recount() rebuilds the counts after the vehicle map
+    // is replaced. Orders in transit are those loaded on outbound vehicles.
+    void setVehicleStatus(Vehicle& vehicle, VehicleStatus status);
+    void recount();
+    int getVehicleCount(VehicleStatus status) const { return m_vehicleCounts[static_cast<int>(status)]; }
+    int getInTransitCount() const { return m_inTransit; }
+    
+    // Waiting orders attemptAssignments() could not place, by cause: in the
+    // last call, and summed over all calls since clearBlockedTotals()
+    struct BlockedCounts {
+        long long noStock = 0;      // no warehouse can fill the order
+        long long noVehicle = 0;    // stock found, but no vehicle free there
+        long long noCapacity = 0;   // vehicles free there, but all too small
+        
+        void add(BlockReason reason);
+    };
+    const BlockedCounts& getLastBlocked() const { return m_lastBlocked; }
+    const BlockedCounts& getBlockedTotals() const { return m_blockedTotals; }
+    void clearBlockedTotals() { m_blockedTotals = BlockedCounts(); }
+    
     // Find best warehouse to fulfill an order
     int findBestWarehouse(const Order& order) const;
     
-    // Find best available vehicle at a warehouse for an order
-    int findBestVehicle(int warehouseId, const Order& order) const;
+    // Find best available vehicle at a warehouse for an order. On failure,
+    // reason (if given) is set to NoCapacity when free vehicles were only
+    // too small, NoVehicle otherwise.
+    int findBestVehicle(int warehouseId, const Order& order, BlockReason* reason = nullptr) const;
     
+private:
     // Calculate travel time
     int getTravelTime(int from, int to) const;
     
@@ -65,10 +94,17 @@ private:
     std::map<int, Warehouse>* m_warehouses;
     std::map<int, Vehicle>* m_vehicles;
     std::vector<std::vector<int>>* m_travelTimes;
+    ChangeSet* m_changes;
     
     // Order queues
     std::vector<int> m_vipQueue;
     std::vector<int> m_stdQueue;
+    
+    // Counters
+    int m_vehicleCounts[4];
+    int m_inTransit;
+    BlockedCounts m_lastBlocked;
+    BlockedCounts m_blockedTotals;
 };
 
 #endif // SCHEDULER_H
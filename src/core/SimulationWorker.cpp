@@ -0,0 +1,287 @@
+#include "SimulationWorker.h"
+#include <algorithm>
+
+namespace {
+const size_t kCommandCapacity = 1024;
+const size_t kLogCapacity = 1 << 16;
+}
+
+SimulationWorker::SimulationWorker(QObject* parent)
+    : QObject(parent), m_simulator(new Simulator()),
+      m_commands(kCommandCapacity), m_wakePending(false),
+      m_logs(kLogCapacity), m_droppedLogs(0), m_notifyPending(false), m_consumedSeq(0),
+      m_logResetMark(0), m_logResets(0), m_logsPopped(0), m_logResetsSeen(0), m_slotSeq{0, 0, 0}, m_lastSeq(0),
+      m_logsQueued(0) {
+
+    // Everything below runs on m_thread: the simulator emits there, and it
+    // is the context object of each connection
+    m_simulator->moveToThread(&m_thread);
+    connect(&m_thread, &QThread::finished, m_simulator, &QObject::deleteLater);
+
+    connect(m_simulator, &Simulator::changed, m_simulator, [this](const ChangeSet& changes) {
+        m_unpublished.merge(changes);
+        if (changes.reset) {
+            // Any reset may bring a new network (a load, or the empty one a
+            // first manual order creates); computed here, off the GUI thread
+            m_layout = std::make_shared<const std::vector<std::pair<double, double>>>(
+                m_simulator->getNodeLayout());
+            // The simulator logs a load or reset after announcing it
+            m_logResetMark.store(m_logsQueued, std::memory_order_release);
+            m_logResets.fetch_add(1, std::memory_order_release);
+        }
+    });
+    connect(m_simulator, &Simulator::timeAdvanced, m_simulator, [this](int) { onStepped(); });
+    connect(m_simulator, &Simulator::simulationFinished, m_simulator, [this]() {
+        publish();
+        emit simulationFinished();
+    });
+    connect(m_simulator, &Simulator::stopTimeReached, m_simulator, [this](int time) {
+        publish();
+        emit stopTimeReached(time);
+    });
+    connect(m_simulator, &Simulator::logMessage, m_simulator, [this](const LogRecord& record) {
+        if (m_logs.push(record)) ++m_logsQueued;
+        else m_droppedLogs.fetch_add(1, std::memory_order_relaxed);
+    });
+
+    m_thread.setObjectName("simulation");
+    m_thread.start();
+}
+
+SimulationWorker::~SimulationWorker() {
+    m_thread.quit();
+    m_thread.wait();
+}
+
+void SimulationWorker::load(const QString& filename) {
+    Command command;
+    command.type = Command::Load;
+    command.filename = filename;
+    post(std::move(command));
+}
+
+void SimulationWorker::saveResults(const QString& filename) {
+    Command command;
+    command.type = Command::Save;
+    command.filename = filename;
+    post(std::move(command));
+}
+
+void SimulationWorker::step() {
+    Command command;
+    command.type = Command::Step;
+    post(std::move(command));
+}
+
+void SimulationWorker::run() {
+    Command command;
+    command.type = Command::Run;
+    post(std::move(command));
+}
+
+void SimulationWorker::pause() {
+    Command command;
+    command.type = Command::Pause;
+    post(std::move(command));
+}
+
+void SimulationWorker::reset() {
+    Command command;
+    command.type = Command::Reset;
+    post(std::move(command));
+}
+
+void SimulationWorker::setSpeed(int msPerStep) {
+    Command command;
+    command.type = Command::SetSpeed;
+    command.value = msPerStep;
+    post(std::move(command));
+}
+
+void SimulationWorker::setTurbo(bool enabled) {
+    Command command;
+    command.type = Command::SetTurbo;
+    command.value = enabled ? 1 : 0;
+    post(std::move(command));
+}
+
+void SimulationWorker::setStopTime(int time) {
+    Command command;
+    command.type = Command::SetStopTime;
+    command.value = time;
+    post(std::move(command));
+}
+
+void SimulationWorker::addManualOrder(int orderId, int dest, int dueBy, bool isVip,
+                                      const std::vector<std::pair<int, int>>& items) {
+    Command command;
+    command.type = Command::AddOrder;
+    command.orderId = orderId;
+    command.dest = dest;
+    command.dueBy = dueBy;
+    command.vip = isVip;
+    command.items = items;
+    post(std::move(command));
+}
+
+void SimulationWorker::cancelOrder(int orderId) {
+    Command command;
+    command.type = Command::CancelOrder;
+    command.orderId = orderId;
+    post(std::move(command));
+}
+
+void SimulationWorker::post(Command command) {
+    // Only a user clicking faster than a long step can fill the queue
+    while (!m_commands.push(command)) QThread::yieldCurrentThread();
+
+    // One wake-up in flight is enough: the worker drains the whole queue
+    if (!m_wakePending.exchange(true, std::memory_order_acq_rel)) {
+        QMetaObject::invokeMethod(m_simulator, [this]() { drainCommands(); }, Qt::QueuedConnection);
+    }
+}
+
+bool SimulationWorker::popLog(LogRecord& record) {
+    if (!m_logs.pop(record)) return false;
+    ++m_logsPopped;
+    return true;
+}
+
+bool SimulationWorker::skipToLastReset() {
+    quint64 resets = m_logResets.load(std::memory_order_acquire);
+    if (resets == m_logResetsSeen) return false;
+    m_logResetsSeen = resets;
+    // At least as new as that reset's mark; everything before it is queued
+    quint64 mark = m_logResetMark.load(std::memory_order_acquire);
+    LogRecord record;
+    while (m_logsPopped < mark && popLog(record)) {}
+    return true;
+}
+
+bool SimulationWorker::acquireSnapshot() {
+    m_notifyPending.exchange(false, std::memory_order_acq_rel);
+    if (!m_snapshots.acquire()) return false;
+    m_consumedSeq.store(m_snapshots.front().seq, std::memory_order_release);
+    return true;
+}
+
+void SimulationWorker::drainCommands() {
+    // Cleared before popping: anything posted from here on wakes us again
+    m_wakePending.exchange(false, std::memory_order_acq_rel);
+    Command command;
+    while (m_commands.pop(command)) execute(command);
+    publish();
+}
+
+void SimulationWorker::execute(Command& command) {
+    switch (command.type) {
+        case Command::Load: {
+            bool ok = m_simulator->loadFromFile(command.filename);
+            emit loadFinished(command.filename, ok, m_simulator->getLoadError());
+            break;
+        }
+        case Command::Save: {
+            bool ok = command.filename.endsWith(".arrow", Qt::CaseInsensitive)
+                ? m_simulator->saveColumnarResults(command.filename)
+                : m_simulator->saveResults(command.filename);
+            emit saveFinished(command.filename, ok);
+            break;
+        }
+        case Command::Step: m_simulator->step(); break;
+        case Command::Run: m_simulator->run(); break;
+        case Command::Pause: m_simulator->pause(); break;
+        case Command::Reset: m_simulator->reset(); break;
+        case Command::SetSpeed: m_simulator->setSpeed(command.value); break;
+        case Command::SetTurbo: m_simulator->setTurbo(command.value != 0); break;
+        case Command::SetStopTime: m_simulator->setStopTime(command.value); break;
+        case Command::AddOrder:
+            m_simulator->addManualOrder(command.orderId, command.dest, command.dueBy,
+                                        command.vip, command.items);
+            break;
+        case Command::CancelOrder: m_simulator->cancelOrder(command.orderId); break;
+    }
+}
+
+void SimulationWorker::onStepped() {
+    // While running, skip copies the GUI would never see; the next step
+    // after it catches up publishes everything since
+    if (m_simulator->isRunning() && m_snapshots.hasUnread()) return;
+    publish();
+}
+
+void SimulationWorker::publish() {
+    quint64 seq = ++m_lastSeq;
+    m_unpublished.normalize();
+    m_history.emplace_back(seq, std::move(m_unpublished));
+    m_unpublished = ChangeSet();
+
+    // The slot we get holds an older snapshot: replay what it missed
+    SimSnapshot& snapshot = m_snapshots.back();
+    ChangeSet missing;
+    for (const auto& entry : m_history) {
+        if (entry.first > snapshot.seq) missing.merge(entry.second);
+    }
+    missing.normalize();
+    if (snapshot.seq == 0 || missing.reset) copyAll(snapshot);
+    else copyChanged(snapshot, missing);
+
+    snapshot.time = m_simulator->getCurrentTime();
+    snapshot.running = m_simulator->isRunning();
+    snapshot.finished = m_simulator->isFinished();
+    snapshot.steps = m_simulator->getPhaseTimings().steps;
+    snapshot.vipQueue = m_simulator->getVipQueue();
+    snapshot.stdQueue = m_simulator->getStdQueue();
+    snapshot.stats = m_simulator->getStatistics();
+    snapshot.layout = m_layout;
+
+    // A stale m_consumedSeq only makes this a superset of what the GUI needs
+    quint64 consumed = m_consumedSeq.load(std::memory_order_acquire);
+    snapshot.changes.clear();
+    for (const auto& entry : m_history) {
+        if (entry.first > consumed) snapshot.changes.merge(entry.second);
+    }
+    snapshot.changes.normalize();
+    snapshot.changes.time = snapshot.time;
+
+    snapshot.seq = seq;
+    m_slotSeq[m_snapshots.backIndex()] = seq;
+    m_snapshots.publish();
+
+    // Every slot, including the GUI's, has seen what is older than the oldest
+    quint64 oldest = std::min({m_slotSeq[0], m_slotSeq[1], m_slotSeq[2]});
+    while (!m_history.empty() && m_history.front().first <= oldest) m_history.pop_front();
+
+    if (!m_notifyPending.exchange(true, std::memory_order_acq_rel)) emit snapshotReady();
+}
+
+void SimulationWorker::copyAll(SimSnapshot& snapshot) {
+    snapshot.orders = m_simulator->getOrders();
+    snapshot.warehouses = m_simulator->getWarehouses();
+    snapshot.vehicles = m_simulator->getVehicles();
+}
+
+void SimulationWorker::copyChanged(SimSnapshot& snapshot, const ChangeSet& missing) {
+    const auto& orders = m_simulator->getOrders();
+    for (int oid : missing.orders) {
+        auto from = orders.find(oid);
+        if (from != orders.end()) snapshot.orders[oid] = from->second;
+        else snapshot.orders.erase(oid);
+    }
+
+    const auto& vehicles = m_simulator->getVehicles();
+    for (int vid : missing.vehicles) {
+        auto from = vehicles.find(vid);
+        if (from != vehicles.end()) snapshot.vehicles[vid] = from->second;
+        else snapshot.vehicles.erase(vid);
+    }
+
+    // Stock is sorted by warehouse: copy each touched warehouse once
+    const auto& warehouses = m_simulator->getWarehouses();
+    int last = -1;
+    for (const auto& stock : missing.stock) {
+        if (stock.first == last) continue;
+        last = stock.first;
+        auto from = warehouses.find(last);
+        if (from != warehouses.end()) snapshot.warehouses[last] = from->second;
+    }
+}
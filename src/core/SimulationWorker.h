@@ -0,0 +1,147 @@
+#ifndef SIMULATIONWORKER_H
+#define SIMULATIONWORKER_H
+
+#include <QObject>
+#include <QString>
+#include <QThread>
+#include <atomic>
+#include <deque>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "ChangeSet.h"
+#include "LogRecord.h"
+#include "Simulator.h"
+#include "SpscQueue.h"
+#include "TripleBuffer.h"
+
+// Everything the GUI shows, copied out of the simulator at one point in time.
+// Only ever read by the GUI thread while it holds it (see SimulationWorker).
+struct SimSnapshot {
+    quint64 seq = 0;             // publish number; 0 until first written
+    int time = 0;
+    bool running = false;
+    bool finished = false;
+    long long steps = 0;         // steps taken since load/reset
+
+    std::map<int, Order> orders;
+    std::map<int, Warehouse> warehouses;
+    std::map<int, Vehicle> vehicles;
+    std::vector<int> vipQueue;
+    std::vector<int> stdQueue;
+    Simulator::Statistics stats;
+    // Node positions for the map; shared, only replaced on load or reset
+    std::shared_ptr<const std::vector<std::pair<double, double>>> layout;
+
+    // Normalized changes since the snapshot the GUI took before this one.
+    // May repeat entries the GUI has already seen; consumers re-read by id.
+    ChangeSet changes;
+};
+
+// Runs a Simulator on its own thread. The GUI thread calls the command
+// methods, which only queue (lock-free, in order), and reads the state
+// through acquireSnapshot()/snapshot(). The worker publishes a snapshot after
+// each batch of commands and after each step the GUI has caught up with, so
+// a fast run costs one copy per GUI frame rather than one per step. Snapshot
+// slots are brought up to date from the change sets they missed instead of
+// being copied whole; neither side ever waits for the other.
+class SimulationWorker : public QObject {
+    Q_OBJECT
+
+public:
+    explicit SimulationWorker(QObject* parent = nullptr);
+    ~SimulationWorker();
+
+    // Commands (GUI thread). Results of load and save come back as signals.
+    void load(const QString& filename);
+    void saveResults(const QString& filename);    // .arrow: columnar results
+    void step();
+    void run();
+    void pause();
+    void reset();
+    void setSpeed(int msPerStep);
+    void setTurbo(bool enabled);
+    void setStopTime(int time);    // -1: run to the end
+    void addManualOrder(int orderId, int dest, int dueBy, bool isVip,
+                        const std::vector<std::pair<int, int>>& items);
+    void cancelOrder(int orderId);
+
+    // Snapshot (GUI thread): acquireSnapshot() returns true if a newer one
+    // was published since the last call; snapshot() stays valid and
+    // unchanged until the next acquireSnapshot()
+    bool acquireSnapshot();
+    const SimSnapshot& snapshot() const { return m_snapshots.front(); }
+
+    // Log records in the order the simulator produced them (GUI thread).
+    // Records that found the queue full are counted instead.
+    bool popLog(LogRecord& record);
+    long long takeDroppedLogs() { return m_droppedLogs.exchange(0); }
+    // Discards records logged before the latest load or reset; returns true
+    // if there was one since the last call, i.e. the log starts over
+    bool skipToLastReset();
+
+signals:
+    // At most one is pending at a time; the GUI acquires to re-arm it
+    void snapshotReady();
+    void loadFinished(const QString& filename, bool ok, const QString& error);
+    void saveFinished(const QString& filename, bool ok);
+    void simulationFinished();
+    void stopTimeReached(int time);
+
+private:
+    struct Command {
+        enum Type { Load, Save, Step, Run, Pause, Reset, SetSpeed, SetTurbo, SetStopTime,
+                    AddOrder, CancelOrder };
+        Type type = Step;
+        QString filename;
+        int orderId = 0;
+        int dest = 0;
+        int dueBy = 0;
+        int value = 0;
+        bool vip = false;
+        std::vector<std::pair<int, int>> items;
+    };
+
+    // GUI thread
+    void post(Command command);
+
+    // Worker thread
+    void drainCommands();
+    void execute(Command& command);
+    void onStepped();
+    void publish();
+    void copyAll(SimSnapshot& snapshot);
+    void copyChanged(SimSnapshot& snapshot, const ChangeSet& missing);
+
+    QThread m_thread;
+    Simulator* m_simulator;    // lives on m_thread
+
+    // GUI -> worker
+    SpscQueue<Command> m_commands;
+    std::atomic<bool> m_wakePending;
+
+    // Worker -> GUI
+    TripleBuffer<SimSnapshot> m_snapshots;
+    SpscQueue<LogRecord> m_logs;
+    std::atomic<long long> m_droppedLogs;
+    std::atomic<bool> m_notifyPending;
+    std::atomic<quint64> m_consumedSeq;    // seq of the GUI's front snapshot
+    std::atomic<quint64> m_logResetMark;   // records queued before the latest reset
+    std::atomic<quint64> m_logResets;      // bumped after the mark is stored
+    
+    // GUI thread only
+    quint64 m_logsPopped;
+    quint64 m_logResetsSeen;
+
+    // Worker thread only. m_history keeps each publish's changes for as
+    // long as some slot (or the GUI) has not seen them.
+    ChangeSet m_unpublished;
+    std::deque<std::pair<quint64, ChangeSet>> m_history;
+    quint64 m_slotSeq[3];
+    quint64 m_lastSeq;
+    quint64 m_logsQueued;
+    std::shared_ptr<const std::vector<std::pair<double, double>>> m_layout;
+};
+
+#endif // SIMULATIONWORKER_H
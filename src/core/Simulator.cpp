@@ -1,47 +1,86 @@
 #include "Simulator.h"
+#include "NetworkLayout.h"
+#include "Profiler.h"
+#include "Tracer.h"
+#include "io/ColumnarWriter.h"
+#include "io/EventStream.h"
 #include "io/InputParser.h"
 #include "io/OutputWriter.h"
 #include <algorithm>
+#include <chrono>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+// Turbo steps per timer tick until this much time has passed
+const auto kTurboBudget = std::chrono::milliseconds(12);
+
+long long elapsedNs(Clock::time_point from, Clock::time_point to) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count();
+}
+}
 
 Simulator::Simulator(QObject* parent)
     : QObject(parent), m_currentTime(0), m_isRunning(false), 
-      m_speedMs(500), m_numWarehouses(0), m_numItems(0), m_numVehicles(0) {
+      m_speedMs(500), m_turbo(false), m_stopTime(-1), m_numWarehouses(0), m_numItems(0), m_numVehicles(0) {
     
     m_timer = new QTimer(this);
     connect(m_timer, &QTimer::timeout, this, &Simulator::onTimerTick);
     
     m_scheduler.setData(&m_orders, &m_warehouses, &m_vehicles, &m_travelTimes);
+    m_scheduler.setChangeSet(&m_changes);
+    m_logLevels.fill(LogLevel::Info);
 }
 
 Simulator::~Simulator() {
     delete m_timer;
 }
 
-bool Simulator::loadFromFile(const QString& filename) {
+bool Simulator::loadFromFile(const QString& filename, bool streaming, int reorderWindow) {
+    Tracer::Span span("load");
     InputParser parser;
-    if (!parser.parse(filename.toStdString())) {
+    bool parsed = streaming
+        ? parser.parseStreaming(filename.toStdString(), static_cast<size_t>(std::max(reorderWindow, 0)))
+        : parser.parse(filename.toStdString());
+    if (!parsed) {
+        m_loadError = QString::fromStdString(parser.getError());
         return false;
     }
+    m_loadError.clear();
     
     m_numWarehouses = parser.getNumWarehouses();
     m_numItems = parser.getNumItems();
     m_numVehicles = parser.getNumVehicles();
     m_travelTimes = parser.getTravelTimes();
+    m_nodeLayout = parser.getNodeCoords();
     m_warehouses = parser.getWarehouses();
     m_vehicles = parser.getVehicles();
+    m_scheduler.recount();
+    m_scheduler.clearBlockedTotals();
+    if (m_metrics.isEnabled()) enableMetrics(m_metrics.capacity(), m_metrics.interval());
     
     // Load events into event manager
     for (const auto& event : parser.getEvents()) {
         m_eventManager.addEvent(event);
     }
+    m_eventStream = parser.getEventStream();
+    m_eventManager.setSource(m_eventStream);
     
     m_currentTime = 0;
     m_isRunning = false;
     m_orders.clear();
     m_deliveredOrders.clear();
-    
-    emit logMessage(QString("Loaded: %1 warehouses, %2 items, %3 vehicles")
-        .arg(m_numWarehouses).arg(m_numItems).arg(m_numVehicles));
+    m_totals = StatisticsTotals();
+    m_latency.clear();
+    m_phaseTimings = PhaseTimings();
+    m_changes.clear();
+    m_changes.reset = true;
+    flushChanges();
+    
+    if (isLogged(LogType::System)) {
+        emit logMessage(LogRecord::system("Loaded: " + std::to_string(m_numWarehouses) + " warehouses, "
+            + std::to_string(m_numItems) + " items, " + std::to_string(m_numVehicles) + " vehicles"));
+    }
     
     return true;
 }
@@ -51,32 +90,109 @@ bool Simulator::saveResults(const QString& filename) {
     return writer.write(filename.toStdString(), m_orders, m_deliveredOrders, getStatistics());
 }
 
+bool Simulator::saveColumnarResults(const QString& filename) {
+    ColumnarResultsWriter writer;
+    if (!writer.open(filename.toStdString())) {
+        logWarning(writer.getError());
+        return false;
+    }
+    for (int oid : m_deliveredOrders) {
+        writer.writeDelivery(m_orders.at(oid));
+    }
+    if (!writer.finish()) {
+        logWarning(writer.getError());
+        return false;
+    }
+    return true;
+}
+
+bool Simulator::openResultsStream(const QString& filename) {
+    m_resultsStream = std::make_unique<StreamingOutputWriter>();
+    if (!m_resultsStream->open(filename.toStdString())) {
+        logWarning(m_resultsStream->getError());
+        m_resultsStream.reset();
+        return false;
+    }
+    return true;
+}
+
+bool Simulator::finishResultsStream() {
+    if (!m_resultsStream) return false;
+    bool ok = m_resultsStream->finish(getStatistics());
+    if (!ok) logWarning(m_resultsStream->getError());
+    m_resultsStream.reset();
+    return ok;
+}
+
+bool Simulator::openColumnarResultsStream(const QString& filename) {
+    m_columnarStream = std::make_unique<ColumnarResultsWriter>();
+    if (!m_columnarStream->open(filename.toStdString())) {
+        logWarning(m_columnarStream->getError());
+        m_columnarStream.reset();
+        return false;
+    }
+    return true;
+}
+
+bool Simulator::finishColumnarResultsStream() {
+    if (!m_columnarStream) return false;
+    bool ok = m_columnarStream->finish();
+    if (!ok) logWarning(m_columnarStream->getError());
+    m_columnarStream.reset();
+    return ok;
+}
+
 void Simulator::step() {
+    auto phaseStart = Clock::now();
+    
     // Process all events at current time
     processEvents();
+    auto eventsDone = Clock::now();
     
     // Process vehicle arrivals
     auto deliveries = m_scheduler.processVehicleArrivals(m_currentTime);
     for (const auto& delivery : deliveries) {
-        m_deliveredOrders.push_back(delivery.orderId);
-        emit orderDelivered(delivery.orderId);
-        emit logMessage(QString("T=%1: Order #%2 delivered").arg(m_currentTime).arg(delivery.orderId));
+        const Order& order = m_orders.at(delivery.orderId);
+        countStatus(order, +1);
+        if (m_resultsStream) m_resultsStream->writeDelivery(order);
+        if (m_columnarStream) m_columnarStream->writeDelivery(order);
+        if (!m_resultsStream && !m_columnarStream && !m_eventStream) m_deliveredOrders.push_back(delivery.orderId);
+        m_changes.delivered.push_back(delivery.orderId);
+        if (isLogged(LogType::Delivery)) {
+            emit logMessage(LogRecord::delivery(m_currentTime, delivery.orderId, order.getAssignedVehicle()));
+        }
+        if (m_eventStream) m_orders.erase(delivery.orderId);
     }
+    auto arrivalsDone = Clock::now();
     
     // Attempt to assign waiting orders
     auto assignments = m_scheduler.attemptAssignments(m_currentTime);
     for (const auto& assignment : assignments) {
-        emit vehicleDispatched(assignment.vehicleId, assignment.orderId);
-        emit logMessage(QString("T=%1: Order #%2 dispatched via Vehicle #%3 from Warehouse #%4")
-            .arg(m_currentTime).arg(assignment.orderId)
-            .arg(assignment.vehicleId).arg(assignment.warehouseId));
+        m_changes.dispatched.push_back({assignment.vehicleId, assignment.orderId});
+        if (isLogged(LogType::Dispatch)) {
+            emit logMessage(LogRecord::dispatch(m_currentTime, assignment.orderId,
+                                                assignment.vehicleId, assignment.warehouseId));
+        }
     }
+    auto assignmentsDone = Clock::now();
+    
+    m_phaseTimings.steps++;
+    m_phaseTimings.eventsNs += elapsedNs(phaseStart, eventsDone);
+    m_phaseTimings.arrivalsNs += elapsedNs(eventsDone, arrivalsDone);
+    m_phaseTimings.assignmentsNs += elapsedNs(arrivalsDone, assignmentsDone);
+    
+    if (Tracer::isActive()) {
+        traceStep(phaseStart, eventsDone, arrivalsDone, assignmentsDone,
+                  static_cast<int>(deliveries.size()), static_cast<int>(assignments.size()));
+    }
+    if (m_metrics.isDue(m_phaseTimings.steps - 1)) recordMetrics();
+    flushChanges();
     
     // Check if simulation is finished
     if (isFinished()) {
         pause();
+        if (isLogged(LogType::System)) emit logMessage(LogRecord::system("Simulation completed!"));
         emit simulationFinished();
-        emit logMessage("Simulation completed!");
         return;
     }
     
@@ -87,7 +203,12 @@ void Simulator::step() {
 
 void Simulator::run() {
     m_isRunning = true;
-    m_timer->start(m_speedMs);
+    m_timer->start(m_turbo ? 0 : m_speedMs);
+}
+
+void Simulator::setTurbo(bool enabled) {
+    m_turbo = enabled;
+    if (m_isRunning) m_timer->start(m_turbo ? 0 : m_speedMs);
 }
 
 void Simulator::pause() {
@@ -100,23 +221,124 @@ void Simulator::reset() {
     m_currentTime = 0;
     m_orders.clear();
     m_deliveredOrders.clear();
+    m_totals = StatisticsTotals();
+    m_latency.clear();
     m_eventManager.clear();
+    m_eventStream.reset();
+    m_resultsStream.reset();
+    m_phaseTimings = PhaseTimings();
+    m_scheduler.clearBlockedTotals();
+    m_metrics.clear();
+    m_changes.clear();
+    m_changes.reset = true;
+    flushChanges();
     emit timeAdvanced(0);
-    emit logMessage("Simulation reset");
+    if (isLogged(LogType::System)) emit logMessage(LogRecord::system("Simulation reset"));
+}
+
+const std::vector<std::pair<double, double>>& Simulator::getNodeLayout() {
+    if (m_nodeLayout.size() != m_travelTimes.size()) {
+        Tracer::Span span("layout");
+        m_nodeLayout = NetworkLayout::compute(m_travelTimes);
+    }
+    return m_nodeLayout;
+}
+
+void Simulator::enableMetrics(size_t capacity, int interval) {
+    m_metrics.configure(capacity, interval, m_warehouses);
+}
+
+bool Simulator::exportMetrics(const QString& filename) {
+    bool ok = filename.endsWith(".arrow", Qt::CaseInsensitive)
+        ? m_metrics.exportArrow(filename.toStdString())
+        : m_metrics.exportCsv(filename.toStdString());
+    if (!ok) logWarning(m_metrics.getError());
+    return ok;
+}
+
+void Simulator::logWarning(const std::string& text) {
+    if (isLogged(LogType::System, LogLevel::Warning)) emit logMessage(LogRecord::system(text));
+}
+
+void Simulator::flushChanges() {
+    m_changes.time = m_currentTime;
+    m_changes.normalize();
+    emit changed(m_changes);
+    m_changes.clear();
+}
+
+void Simulator::recordMetrics() {
+    const Scheduler::BlockedCounts& blocked = m_scheduler.getLastBlocked();
+    int values[MetricsRecorder::ColumnCount];
+    values[MetricsRecorder::Time] = m_currentTime;
+    values[MetricsRecorder::VipQueue] = m_scheduler.getVipQueueSize();
+    values[MetricsRecorder::StdQueue] = m_scheduler.getStandardQueueSize();
+    values[MetricsRecorder::VehiclesAvailable] = m_scheduler.getVehicleCount(VehicleStatus::Available);
+    values[MetricsRecorder::VehiclesOutbound] = m_scheduler.getVehicleCount(VehicleStatus::Outbound);
+    values[MetricsRecorder::VehiclesReturning] = m_scheduler.getVehicleCount(VehicleStatus::Returning);
+    values[MetricsRecorder::VehiclesMaintenance] = m_scheduler.getVehicleCount(VehicleStatus::Maintenance);
+    values[MetricsRecorder::InTransit] = m_scheduler.getInTransitCount();
+    values[MetricsRecorder::BlockedNoStock] = blocked.noStock;
+    values[MetricsRecorder::BlockedNoVehicle] = blocked.noVehicle;
+    values[MetricsRecorder::BlockedNoCapacity] = blocked.noCapacity;
+    m_metrics.record(values);
+}
+
+void Simulator::traceStep(Clock::time_point start, Clock::time_point eventsDone,
+                          Clock::time_point arrivalsDone, Clock::time_point assignmentsDone,
+                          int deliveries, int assignments) {
+    long long vipQueue = m_scheduler.getVipQueueSize();
+    long long stdQueue = m_scheduler.getStandardQueueSize();
+    const Scheduler::BlockedCounts& blocked = m_scheduler.getLastBlocked();
+    Tracer::complete("step", start, assignmentsDone,
+                     {{"time", m_currentTime}, {"vip_queue", vipQueue}, {"std_queue", stdQueue},
+                      {"deliveries", deliveries}, {"assignments", assignments}});
+    Tracer::complete("events", start, eventsDone, {{"time", m_currentTime}});
+    Tracer::complete("arrivals", eventsDone, arrivalsDone, {{"deliveries", deliveries}});
+    Tracer::complete("assignments", arrivalsDone, assignmentsDone,
+                     {{"assigned", assignments}, {"blocked_no_stock", blocked.noStock},
+                      {"blocked_no_vehicle", blocked.noVehicle}, {"blocked_no_capacity", blocked.noCapacity}});
+    
+    Tracer::counter("backlog", assignmentsDone,
+                    {{"vip", vipQueue}, {"standard", stdQueue}, {"in_transit", m_scheduler.getInTransitCount()}});
+    long long busy = m_scheduler.getVehicleCount(VehicleStatus::Outbound) +
+                     m_scheduler.getVehicleCount(VehicleStatus::Returning);
+    long long fleet = static_cast<long long>(m_vehicles.size());
+    Tracer::counter("fleet utilization %", assignmentsDone, {{"busy", fleet > 0 ? busy * 100 / fleet : 0}});
+}
+
+QString Simulator::getStreamError() const {
+    return m_eventStream ? QString::fromStdString(m_eventStream->getError()) : QString();
+}
+
+long long Simulator::getLateEvents() const {
+    return m_eventStream ? m_eventStream->getLateEvents() : 0;
 }
 
 bool Simulator::isFinished() const {
     return !m_eventManager.hasEvents() && 
            !m_scheduler.hasWaitingOrders() &&
-           std::all_of(m_vehicles.begin(), m_vehicles.end(),
-               [](const auto& v) { return v.second.getStatus() == VehicleStatus::Available; });
+           m_scheduler.getVehicleCount(VehicleStatus::Available) == static_cast<int>(m_vehicles.size());
 }
 
 void Simulator::onTimerTick() {
-    step();
+    auto deadline = Clock::now() + kTurboBudget;
+    do {
+        // Only crossing the stop time stops: running again goes on past it
+        int before = m_currentTime;
+        step();
+        if (m_isRunning && m_stopTime >= 0 && before < m_stopTime && m_currentTime >= m_stopTime) {
+            pause();
+            if (isLogged(LogType::System)) {
+                emit logMessage(LogRecord::system("Stopped at T=" + std::to_string(m_currentTime)));
+            }
+            emit stopTimeReached(m_currentTime);
+        }
+    } while (m_turbo && m_isRunning && Clock::now() < deadline);
 }
 
 void Simulator::processEvents() {
+    WDS_PROFILE_SCOPE(ProcessEvents);
     auto events = m_eventManager.getEventsAt(m_currentTime);
     
     for (const auto& event : events) {
@@ -141,6 +363,7 @@ void Simulator::processEvents() {
 }
 
 void Simulator::processOrderArrival(OrderArrivalEvent* event) {
+    WDS_PROFILE_SCOPE(OrderArrival);
     if (!event) return;
     
     double value = 0;
@@ -153,7 +376,10 @@ void Simulator::processOrderArrival(OrderArrivalEvent* event) {
                 event->isVip() ? PriorityClass::VIP : PriorityClass::Standard,
                 value, event->getDemand());
     
+    auto existing = m_orders.find(event->getOrderId());
+    if (existing != m_orders.end()) countOrder(existing->second, -1);
     m_orders[event->getOrderId()] = order;
+    countOrder(order, +1);
     
     if (event->isVip()) {
         m_scheduler.addVipOrder(event->getOrderId());
@@ -161,46 +387,61 @@ void Simulator::processOrderArrival(OrderArrivalEvent* event) {
         m_scheduler.addStandardOrder(event->getOrderId());
     }
     
-    emit orderArrived(event->getOrderId());
-    emit logMessage(QString("T=%1: %2").arg(m_currentTime).arg(QString::fromStdString(event->getDescription())));
+    m_changes.orders.push_back(event->getOrderId());
+    m_changes.arrived.push_back(event->getOrderId());
+    if (isLogged(LogType::Arrival)) {
+        emit logMessage(LogRecord::arrival(m_currentTime, event->getOrderId(), event->getDestination(), event->isVip()));
+    }
 }
 
 void Simulator::processRestock(RestockEvent* event) {
+    WDS_PROFILE_SCOPE(Restock);
     if (!event) return;
     
     Warehouse& warehouse = m_warehouses[event->getWarehouseId()];
     for (const auto& item : event->getItems()) {
         warehouse.addInventory(item.first, item.second);
+        m_changes.stock.push_back({event->getWarehouseId(), item.first});
+    }
+    m_changes.restocked.push_back(event->getWarehouseId());
+    if (isLogged(LogType::Restock)) {
+        emit logMessage(LogRecord::restock(m_currentTime, event->getWarehouseId(),
+                                           static_cast<int>(event->getItems().size())));
     }
-    
-    emit inventoryRestocked(event->getWarehouseId());
-    emit logMessage(QString("T=%1: %2").arg(m_currentTime).arg(QString::fromStdString(event->getDescription())));
 }
 
 void Simulator::processCancel(CancelEvent* event) {
+    WDS_PROFILE_SCOPE(Cancel);
     if (!event) return;
     
     auto it = m_orders.find(event->getOrderId());
     if (it != m_orders.end() && it->second.getStatus() == OrderStatus::Waiting) {
         it->second.setStatus(OrderStatus::Canceled);
+        countStatus(it->second, +1);
         m_scheduler.removeFromQueues(event->getOrderId());
-        emit orderCanceled(event->getOrderId());
-        emit logMessage(QString("T=%1: %2").arg(m_currentTime).arg(QString::fromStdString(event->getDescription())));
+        m_changes.orders.push_back(event->getOrderId());
+        m_changes.canceled.push_back(event->getOrderId());
+        if (isLogged(LogType::Cancel)) emit logMessage(LogRecord::cancel(m_currentTime, event->getOrderId()));
+        if (m_eventStream) m_orders.erase(it);
     }
 }
 
 void Simulator::processMaintenance(MaintenanceEvent* event) {
+    WDS_PROFILE_SCOPE(Maintenance);
     if (!event) return;
     
     auto it = m_vehicles.find(event->getVehicleId());
     if (it != m_vehicles.end() && it->second.getStatus() == VehicleStatus::Available) {
-        it->second.setStatus(VehicleStatus::Maintenance);
+        m_scheduler.setVehicleStatus(it->second, VehicleStatus::Maintenance);
         it->second.setAvailableTime(m_currentTime + event->getDuration());
-        emit logMessage(QString("T=%1: %2").arg(m_currentTime).arg(QString::fromStdString(event->getDescription())));
+        if (isLogged(LogType::Maintenance)) {
+            emit logMessage(LogRecord::maintenance(m_currentTime, event->getVehicleId(), event->getDuration()));
+        }
     }
 }
 
 void Simulator::processReroute(RerouteEvent* event) {
+    WDS_PROFILE_SCOPE(Reroute);
     if (!event) return;
     
     int a = event->getNodeA();
@@ -208,47 +449,53 @@ void Simulator::processReroute(RerouteEvent* event) {
     if (a < static_cast<int>(m_travelTimes.size()) && b < static_cast<int>(m_travelTimes[a].size())) {
         m_travelTimes[a][b] = event->getNewTime();
         m_travelTimes[b][a] = event->getNewTime();
-        emit logMessage(QString("T=%1: %2").arg(m_currentTime).arg(QString::fromStdString(event->getDescription())));
+        if (isLogged(LogType::Reroute)) {
+            emit logMessage(LogRecord::reroute(m_currentTime, a, b, event->getNewTime()));
+        }
     }
 }
 
 Simulator::Statistics Simulator::getStatistics() const {
     Statistics stats;
-    stats.totalOrders = m_orders.size();
-    
-    double totalWait = 0, totalTransit = 0;
-    int onTime = 0;
-    
-    for (const auto& [oid, order] : m_orders) {
-        if (order.getPriorityClass() == PriorityClass::VIP) stats.vipOrders++;
-        else stats.stdOrders++;
-        
-        if (order.getStatus() == OrderStatus::Delivered) {
-            stats.deliveredOrders++;
-            stats.totalValue += order.getValue();
-            
-            int waitTime = order.getAssignTime() - order.getRequestTime();
-            int transitTime = order.getFinishTime() - order.getDispatchTime();
-            totalWait += waitTime;
-            totalTransit += transitTime;
-            
-            if (order.getDueBy() == 0 || order.getFinishTime() <= order.getDueBy()) {
-                onTime++;
-            }
-        } else if (order.getStatus() == OrderStatus::Canceled) {
-            stats.canceledOrders++;
-        }
-    }
-    
-    if (stats.deliveredOrders > 0) {
-        stats.avgWaitTime = totalWait / stats.deliveredOrders;
-        stats.avgTransitTime = totalTransit / stats.deliveredOrders;
-        stats.onTimeRate = static_cast<double>(onTime) / stats.deliveredOrders * 100;
+    stats.totalOrders = static_cast<int>(m_totals.orders);
+    stats.vipOrders = static_cast<int>(m_totals.vipOrders);
+    stats.stdOrders = static_cast<int>(m_totals.orders - m_totals.vipOrders);
+    stats.deliveredOrders = static_cast<int>(m_totals.delivered);
+    stats.canceledOrders = static_cast<int>(m_totals.canceled);
+    stats.totalValue = m_totals.value;
+    
+    if (m_totals.delivered > 0) {
+        stats.avgWaitTime = m_totals.wait / m_totals.delivered;
+        stats.avgTransitTime = m_totals.transit / m_totals.delivered;
+        stats.onTimeRate = static_cast<double>(m_totals.onTime) / m_totals.delivered * 100;
     }
+    stats.latency = m_latency.summary();
     
     return stats;
 }
 
+void Simulator::countOrder(const Order& order, int sign) {
+    m_totals.orders += sign;
+    if (order.getPriorityClass() == PriorityClass::VIP) m_totals.vipOrders += sign;
+    countStatus(order, sign);
+}
+
+void Simulator::countStatus(const Order& order, int sign) {
+    if (order.getStatus() == OrderStatus::Delivered) {
+        m_totals.delivered += sign;
+        m_totals.value += sign * order.getValue();
+        m_totals.wait += sign * (order.getAssignTime() - order.getRequestTime());
+        m_totals.transit += sign * (order.getFinishTime() - order.getDispatchTime());
+        if (order.getDueBy() == 0 || order.getFinishTime() <= order.getDueBy()) {
+            m_totals.onTime += sign;
+        }
+        if (sign > 0) m_latency.record(order);
+        else m_latency.remove(order);
+    } else if (order.getStatus() == OrderStatus::Canceled) {
+        m_totals.canceled += sign;
+    }
+}
+
 void Simulator::addManualOrder(int orderId, int dest, int dueBy, bool isVip,
                                const std::vector<std::pair<int, int>>& items) {
     // Initialize empty simulation if no data loaded
@@ -265,7 +512,10 @@ void Simulator::addManualOrder(int orderId, int dest, int dueBy, bool isVip,
                 isVip ? PriorityClass::VIP : PriorityClass::Standard,
                 value, items);
     
+    auto existing = m_orders.find(orderId);
+    if (existing != m_orders.end()) countOrder(existing->second, -1);
     m_orders[orderId] = order;
+    countOrder(order, +1);
     
     if (isVip) {
         m_scheduler.addVipOrder(orderId);
@@ -273,18 +523,23 @@ void Simulator::addManualOrder(int orderId, int dest, int dueBy, bool isVip,
         m_scheduler.addStandardOrder(orderId);
     }
     
-    emit orderArrived(orderId);
-    emit logMessage(QString("T=%1: Manual order #%2 added (%3)")
-        .arg(m_currentTime).arg(orderId).arg(isVip ? "VIP" : "Standard"));
+    m_changes.orders.push_back(orderId);
+    m_changes.arrived.push_back(orderId);
+    flushChanges();
+    if (isLogged(LogType::Arrival)) emit logMessage(LogRecord::manualArrival(m_currentTime, orderId, isVip));
 }
 
 void Simulator::cancelOrder(int orderId) {
     auto it = m_orders.find(orderId);
     if (it != m_orders.end() && it->second.getStatus() == OrderStatus::Waiting) {
         it->second.setStatus(OrderStatus::Canceled);
+        countStatus(it->second, +1);
         m_scheduler.removeFromQueues(orderId);
-        emit orderCanceled(orderId);
-        emit logMessage(QString("T=%1: Order #%2 canceled").arg(m_currentTime).arg(orderId));
+        m_changes.orders.push_back(orderId);
+        m_changes.canceled.push_back(orderId);
+        flushChanges();
+        if (isLogged(LogType::Cancel)) emit logMessage(LogRecord::cancel(m_currentTime, orderId));
+        if (m_eventStream) m_orders.erase(it);
     }
 }
 
@@ -298,6 +553,7 @@ void Simulator::initializeEmpty(int numWarehouses, int numItems, int numVehicles
     for (int i = 0; i <= numWarehouses; ++i) {
         m_travelTimes[i][i] = 0;
     }
+    m_nodeLayout.clear();
     
     // Create warehouses with initial inventory
     for (int i = 1; i <= numWarehouses; ++i) {
@@ -318,8 +574,16 @@ void Simulator::initializeEmpty(int numWarehouses, int numItems, int numVehicles
     if (vid <= numVehicles) {
         m_vehicles[vid] = Vehicle(vid, VehicleType::Refrigerated, 3, 80, 1);
     }
-    
-    emit logMessage(QString("Initialized empty simulation: %1 warehouses, %2 items, %3 vehicles")
-        .arg(numWarehouses).arg(numItems).arg(m_vehicles.size()));
+    m_scheduler.recount();
+    m_scheduler.clearBlockedTotals();
+    if (m_metrics.isEnabled()) enableMetrics(m_metrics.capacity(), m_metrics.interval());
+    m_changes.clear();
+    m_changes.reset = true;
+    flushChanges();
+    
+    if (isLogged(LogType::System)) {
+        emit logMessage(LogRecord::system("Initialized empty simulation: " + std::to_string(numWarehouses)
+            + " warehouses, " + std::to_string(numItems) + " items, " + std::to_string(m_vehicles.size()) + " vehicles"));
+    }
 }
 
@@ -3,14 +3,25 @@
 
 #include <QObject>
 #include <QTimer>
+#include <array>
+#include <chrono>
 #include <map>
+#include <memory>
 #include <vector>
+#include "ChangeSet.h"
 #include "EventManager.h"
+#include "LatencyHistogram.h"
+#include "LogRecord.h"
+#include "MetricsRecorder.h"
 #include "Scheduler.h"
 #include "models/Order.h"
 #include "models/Warehouse.h"
 #include "models/Vehicle.h"
 
+class ColumnarResultsWriter;
+class EventStream;
+class StreamingOutputWriter;
+
 class Simulator : public QObject {
     Q_OBJECT
     
@@ -18,10 +29,28 @@ public:
     explicit Simulator(QObject* parent = nullptr);
     ~Simulator();
     
-    // Data loading
-    bool loadFromFile(const QString& filename);
+    // Data loading. With streaming, events are read from the file as the
+    // simulation reaches them instead of being loaded up front, and orders
+    // are dropped once delivered or canceled (after being counted and
+    // streamed), so only open orders stay in getOrders().
+    bool loadFromFile(const QString& filename, bool streaming = false, int reorderWindow = 0);
+    // Why the last loadFromFile() failed (empty after a successful load)
+    QString getLoadError() const { return m_loadError; }
     bool saveResults(const QString& filename);
     
+    // Delivered orders as an Arrow file plus per-vehicle and per-warehouse
+    // aggregates next to it (see ColumnarResultsWriter)
+    bool saveColumnarResults(const QString& filename);
+    
+    // Writes each delivery to filename as it happens instead of keeping the
+    // file for saveResults(); finishResultsStream() appends the statistics.
+    // While a results stream is open, deliveries are not kept for
+    // saveResults()/saveColumnarResults().
+    bool openResultsStream(const QString& filename);
+    bool finishResultsStream();
+    bool openColumnarResultsStream(const QString& filename);
+    bool finishColumnarResultsStream();
+    
     // Simulation control
     void step();           // Advance one timestep
     void run();            // Start continuous simulation
@@ -32,6 +61,14 @@ public:
     void setSpeed(int msPerStep) { m_speedMs = msPerStep; }
     int getSpeed() const { return m_speedMs; }
     
+    // Turbo ignores the speed: each timer tick runs steps until a frame's
+    // worth of time is spent, then lets the event loop in
+    void setTurbo(bool enabled);
+    bool isTurbo() const { return m_turbo; }
+    // A run pauses once the time reaches this (-1: run to the end)
+    void setStopTime(int time) { m_stopTime = time; }
+    int getStopTime() const { return m_stopTime; }
+    
     // State queries
     int getCurrentTime() const { return m_currentTime; }
     bool isRunning() const { return m_isRunning; }
@@ -42,10 +79,19 @@ public:
     const std::map<int, Warehouse>& getWarehouses() const { return m_warehouses; }
     const std::map<int, Vehicle>& getVehicles() const { return m_vehicles; }
     const std::vector<int>& getDeliveredOrders() const { return m_deliveredOrders; }
+    int getDeliveredCount() const { return static_cast<int>(m_totals.delivered); }
+    // (x, y) per node, indexed like the travel matrix: the scenario's COORDS
+    // block if it has one, else a layout computed from the travel times on
+    // first use and kept until the next load. Units are arbitrary.
+    const std::vector<std::pair<double, double>>& getNodeLayout();
     
     // Queue access
     std::vector<int> getVipQueue() const { return m_scheduler.getVipQueue(); }
     std::vector<int> getStdQueue() const { return m_scheduler.getStandardQueue(); }
+    int getWaitingOrderCount() const {
+        return m_scheduler.getVipQueueSize() + m_scheduler.getStandardQueueSize();
+    }
+    bool hasPendingEvents() const { return m_eventManager.hasEvents(); }
     
     // Manual order management (GUI input)
     void addManualOrder(int orderId, int dest, int dueBy, bool isVip,
@@ -66,19 +112,52 @@ public:
         double avgWaitTime = 0;
         double avgTransitTime = 0;
         double onTimeRate = 0;
+        LatencyStats::Summary latency;    // percentiles of delivered orders
     };
-    Statistics getStatistics() const;
+    Statistics getStatistics() const;     // O(1), from running totals
+    
+    // Wall-clock time spent in each phase of step(), accumulated since load/reset
+    struct PhaseTimings {
+        long long steps = 0;
+        long long eventsNs = 0;
+        long long arrivalsNs = 0;
+        long long assignmentsNs = 0;
+    };
+    const PhaseTimings& getPhaseTimings() const { return m_phaseTimings; }
+    int getProcessedEvents() const { return m_eventManager.getTotalEvents(); }
+    
+    // Skipped assignment attempts by cause since load/reset
+    const Scheduler::BlockedCounts& getBlockedTotals() const { return m_scheduler.getBlockedTotals(); }
+    
+    // Time series sampled every interval steps into a ring of capacity
+    // samples (0 disables). Survives reloads; the warehouse set is re-read.
+    void enableMetrics(size_t capacity, int interval = 1);
+    const MetricsRecorder& getMetrics() const { return m_metrics; }
+    bool exportMetrics(const QString& filename);    // .arrow or CSV
+    
+    // Streaming mode: read error (empty if none) and events that arrived
+    // after later timestamps than the reorder window could absorb
+    QString getStreamError() const;
+    long long getLateEvents() const;
+    
+    // logMessage() is emitted only for records at or below their type's
+    // level (default Info); below it nothing is built at all
+    void setLogLevel(LogType type, LogLevel level) { m_logLevels[static_cast<int>(type)] = level; }
+    void setLogLevel(LogLevel level) { m_logLevels.fill(level); }
+    LogLevel getLogLevel(LogType type) const { return m_logLevels[static_cast<int>(type)]; }
+    bool isLogged(LogType type, LogLevel level = LogLevel::Info) const {
+        return level <= m_logLevels[static_cast<int>(type)];
+    }
     
 signals:
     void timeAdvanced(int newTime);
-    void orderArrived(int orderId);
-    void orderDelivered(int orderId);
-    void orderCanceled(int orderId);
-    void vehicleDispatched(int vehicleId, int orderId);
-    void vehicleReturned(int vehicleId);
-    void inventoryRestocked(int warehouseId);
+    // Once per step (and per manual change, load or reset) with everything
+    // that changed since the previous one; only valid during the call
+    void changed(const ChangeSet& changes);
     void simulationFinished();
-    void logMessage(const QString& message);
+    void stopTimeReached(int time);
+    // Render with formatLogRecord(); only valid during the call
+    void logMessage(const LogRecord& record);
     
 private slots:
     void onTimerTick();
@@ -91,14 +170,32 @@ private:
     void processMaintenance(MaintenanceEvent* event);
     void processReroute(RerouteEvent* event);
     
+    // Keep m_totals in step with m_orders: countOrder() adds or removes an
+    // order entirely, countStatus() only what depends on its current status
+    void countOrder(const Order& order, int sign);
+    void countStatus(const Order& order, int sign);
+    void recordMetrics();
+    void flushChanges();
+    void logWarning(const std::string& text);
+    void traceStep(std::chrono::steady_clock::time_point start,
+                   std::chrono::steady_clock::time_point eventsDone,
+                   std::chrono::steady_clock::time_point arrivalsDone,
+                   std::chrono::steady_clock::time_point assignmentsDone,
+                   int deliveries, int assignments);
+    
     // Time management
     int m_currentTime;
     bool m_isRunning;
     int m_speedMs;
+    bool m_turbo;
+    int m_stopTime;
     QTimer* m_timer;
     
     // Core components
     EventManager m_eventManager;
+    std::shared_ptr<EventStream> m_eventStream;
+    std::unique_ptr<StreamingOutputWriter> m_resultsStream;
+    std::unique_ptr<ColumnarResultsWriter> m_columnarStream;
     Scheduler m_scheduler;
     
     // Data storage
@@ -106,9 +203,27 @@ private:
     std::map<int, Warehouse> m_warehouses;
     std::map<int, Vehicle> m_vehicles;
     std::vector<std::vector<int>> m_travelTimes;
+    std::vector<std::pair<double, double>> m_nodeLayout;    // empty until needed
+    QString m_loadError;
     
     // Tracking
     std::vector<int> m_deliveredOrders;
+    struct StatisticsTotals {
+        long long orders = 0;
+        long long vipOrders = 0;
+        long long delivered = 0;
+        long long canceled = 0;
+        long long onTime = 0;
+        double value = 0;
+        double wait = 0;
+        double transit = 0;
+    };
+    StatisticsTotals m_totals;
+    LatencyStats m_latency;
+    MetricsRecorder m_metrics;
+    ChangeSet m_changes;
+    PhaseTimings m_phaseTimings;
+    std::array<LogLevel, kLogTypeCount> m_logLevels;
     int m_numWarehouses;
     int m_numItems;
     int m_numVehicles;
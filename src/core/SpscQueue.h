@@ -0,0 +1,66 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Bounded queue for exactly one producer thread and one consumer thread.
+// push() and pop() never lock or block; push() fails when the queue is full.
+// Each side keeps a cached copy of the other's index and only reloads it
+// when the cache says full (or empty), so the shared cache lines are touched
+// about once per lap rather than once per element.
+template <typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(size_t capacity)
+        : m_slots(roundUp(capacity)), m_mask(m_slots.size() - 1) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer thread only
+    bool push(T value) {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_headCache == m_slots.size()) {
+            m_headCache = m_head.load(std::memory_order_acquire);
+            if (tail - m_headCache == m_slots.size()) return false;
+        }
+        m_slots[tail & m_mask] = std::move(value);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer thread only
+    bool pop(T& value) {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tailCache) {
+            m_tailCache = m_tail.load(std::memory_order_acquire);
+            if (head == m_tailCache) return false;
+        }
+        value = std::move(m_slots[head & m_mask]);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t capacity() const { return m_slots.size(); }
+
+private:
+    static size_t roundUp(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) size *= 2;
+        return size;
+    }
+
+    std::vector<T> m_slots;
+    size_t m_mask;
+
+    // Indices only grow; the slot is index & m_mask
+    alignas(64) std::atomic<size_t> m_head{0};    // next to pop
+    size_t m_tailCache = 0;                       // consumer's view of m_tail
+    alignas(64) std::atomic<size_t> m_tail{0};    // next to push
+    size_t m_headCache = 0;                       // producer's view of m_head
+};
+
+#endif // SPSCQUEUE_H
@@ -0,0 +1,140 @@
+#include "Tracer.h"
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+using Tracer::Arg;
+using Tracer::Clock;
+
+struct Event {
+    const char* name;
+    long long ts;     // ns since start()
+    long long dur;
+    char phase;       // 'X' span, 'C' counter
+    int argCount;
+    Arg args[Tracer::kMaxArgs];
+};
+
+// Only the owning thread appends; the registry lock is taken once per thread
+// and by start()/stop()
+struct ThreadBuffer {
+    std::vector<Event> events;
+    const char* name = nullptr;
+    int tid = 0;
+    std::atomic<bool> retired{false};
+};
+
+std::mutex g_registryMutex;
+std::vector<std::unique_ptr<ThreadBuffer>> g_buffers;
+int g_nextTid = 1;
+Clock::time_point g_origin;
+
+// Marks the buffer retired when its thread exits; the events stay until the
+// next start() so short-lived workers still show up in the trace
+struct BufferHandle {
+    ThreadBuffer* buffer = nullptr;
+    ~BufferHandle() {
+        if (buffer) buffer->retired.store(true, std::memory_order_relaxed);
+    }
+};
+thread_local BufferHandle t_handle;
+
+ThreadBuffer& localBuffer() {
+    if (!t_handle.buffer) {
+        std::lock_guard<std::mutex> lock(g_registryMutex);
+        g_buffers.push_back(std::make_unique<ThreadBuffer>());
+        g_buffers.back()->tid = g_nextTid++;
+        g_buffers.back()->events.reserve(4096);
+        t_handle.buffer = g_buffers.back().get();
+    }
+    return *t_handle.buffer;
+}
+
+void append(char phase, const char* name, Clock::time_point begin, Clock::time_point end,
+            std::initializer_list<Arg> args) {
+    Event event;
+    event.name = name;
+    event.ts = std::chrono::duration_cast<std::chrono::nanoseconds>(begin - g_origin).count();
+    event.dur = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+    event.phase = phase;
+    event.argCount = 0;
+    for (const Arg& arg : args) {
+        if (arg.key && event.argCount < Tracer::kMaxArgs) event.args[event.argCount++] = arg;
+    }
+    localBuffer().events.push_back(event);
+}
+
+void writeArgs(std::FILE* file, const Event& event) {
+    std::fputs(",\"args\":{", file);
+    for (int a = 0; a < event.argCount; ++a) {
+        std::fprintf(file, a ? ",\"%s\":%lld" : "\"%s\":%lld", event.args[a].key, event.args[a].value);
+    }
+    std::fputc('}', file);
+}
+}
+
+namespace Tracer {
+
+void start() {
+    std::lock_guard<std::mutex> lock(g_registryMutex);
+    g_buffers.erase(std::remove_if(g_buffers.begin(), g_buffers.end(),
+                                   [](const std::unique_ptr<ThreadBuffer>& buffer) {
+                                       return buffer->retired.load(std::memory_order_relaxed);
+                                   }),
+                    g_buffers.end());
+    for (auto& buffer : g_buffers) buffer->events.clear();
+    g_origin = Clock::now();
+    g_active.store(true, std::memory_order_release);
+}
+
+bool stop(const std::string& filename, std::string& error) {
+    g_active.store(false, std::memory_order_release);
+    std::lock_guard<std::mutex> lock(g_registryMutex);
+
+    std::FILE* file = std::fopen(filename.c_str(), "w");
+    if (!file) {
+        error = "Could not open file for writing: " + filename;
+        return false;
+    }
+
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+    std::fputs("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"WarehouseDeliverySystem\"}}", file);
+    for (const auto& buffer : g_buffers) {
+        if (buffer->name) {
+            std::fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+                               "\"args\":{\"name\":\"%s\"}}", buffer->tid, buffer->name);
+        }
+        for (const Event& event : buffer->events) {
+            // Trace Event timestamps are microseconds
+            std::fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"%c\",\"pid\":1,\"tid\":%d,\"ts\":%.3f",
+                         event.name, event.phase, buffer->tid, event.ts / 1e3);
+            if (event.phase == 'X') std::fprintf(file, ",\"dur\":%.3f", event.dur / 1e3);
+            writeArgs(file, event);
+            std::fputc('}', file);
+        }
+    }
+    std::fputs("\n]}\n", file);
+
+    bool ok = std::ferror(file) == 0;
+    ok = (std::fclose(file) == 0) && ok;
+    if (!ok) error = "Write error while saving " + filename;
+    return ok;
+}
+
+void setThreadName(const char* name) {
+    if (isActive()) localBuffer().name = name;
+}
+
+void complete(const char* name, Clock::time_point begin, Clock::time_point end,
+              std::initializer_list<Arg> args) {
+    append('X', name, begin, end, args);
+}
+
+void counter(const char* name, Clock::time_point at, std::initializer_list<Arg> args) {
+    append('C', name, at, at, args);
+}
+
+} // namespace Tracer
@@ -0,0 +1,67 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+
+// Execution trace in Chrome Trace Event format (load the JSON in Perfetto or
+// chrome://tracing). Each thread appends to its own buffer without locking;
+// buffers are written out by stop(). start() and stop() must not overlap with
+// other threads recording. When tracing is off every call is one relaxed load.
+namespace Tracer {
+
+using Clock = std::chrono::steady_clock;
+
+struct Arg {
+    const char* key;
+    long long value;
+};
+
+constexpr int kMaxArgs = 6;
+
+inline std::atomic<bool> g_active{false};
+inline bool isActive() { return g_active.load(std::memory_order_relaxed); }
+
+// Clears all buffers and starts recording; timestamps are relative to now
+void start();
+// Writes everything recorded so far to filename and stops recording
+bool stop(const std::string& filename, std::string& error);
+
+// Names the calling thread's track. Names must be string literals (or
+// otherwise outlive the trace), as must span, counter and argument names.
+void setThreadName(const char* name);
+
+// A span from begin to end on the calling thread's track, args shown on click
+void complete(const char* name, Clock::time_point begin, Clock::time_point end,
+              std::initializer_list<Arg> args = {});
+// Values of a counter track, one series per arg
+void counter(const char* name, Clock::time_point at, std::initializer_list<Arg> args);
+
+// Records a span for the enclosing scope when tracing is on
+class Span {
+public:
+    explicit Span(const char* name) : m_name(name), m_active(isActive()) {
+        if (m_active) m_begin = Clock::now();
+    }
+    ~Span() {
+        if (m_active) complete(m_name, m_begin, Clock::now(), {m_arg});
+    }
+
+    void setArg(const char* key, long long value) { m_arg = {key, value}; }
+
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+
+private:
+    const char* m_name;
+    bool m_active;
+    Clock::time_point m_begin;
+    Arg m_arg{nullptr, 0};
+};
+
+} // namespace Tracer
+
+#endif // TRACER_H
@@ -0,0 +1,52 @@
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <array>
+#include <atomic>
+
+// Hands the latest value from one writer thread to one reader thread without
+// locks. Each side owns one of three slots; the third sits in the middle and
+// the two sides swap their slot with it through a single atomic. The writer
+// never waits for the reader and the reader always gets the newest complete
+// value; values the reader was too slow to take are skipped.
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // Writer: fill back(), then publish() it. back() then returns another
+    // slot holding whatever was last written into it, not the new value.
+    T& back() { return m_slots[m_back]; }
+    int backIndex() const { return m_back; }
+    void publish() {
+        int previous = m_middle.exchange(m_back | kFresh, std::memory_order_acq_rel);
+        m_back = previous & kIndexMask;
+    }
+    // True until the reader takes the last published value
+    bool hasUnread() const { return (m_middle.load(std::memory_order_relaxed) & kFresh) != 0; }
+
+    // Reader: acquire() moves the newest value to front(), if there is one
+    // it has not seen. front() does not change until the next acquire().
+    bool acquire() {
+        if (!hasUnread()) return false;
+        // Only the writer touches the middle besides us and it always leaves
+        // it fresh, so the slot we get back is the newest one
+        int previous = m_middle.exchange(m_front, std::memory_order_acq_rel);
+        m_front = previous & kIndexMask;
+        return true;
+    }
+    const T& front() const { return m_slots[m_front]; }
+
+private:
+    static constexpr int kIndexMask = 3;
+    static constexpr int kFresh = 4;
+
+    std::array<T, 3> m_slots;
+    int m_back = 0;
+    alignas(64) std::atomic<int> m_middle{1};
+    alignas(64) int m_front = 2;
+};
+
+#endif // TRIPLEBUFFER_H
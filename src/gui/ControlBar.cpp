@@ -57,6 +57,32 @@ ControlBar::ControlBar(QWidget* parent)
     m_speedLabel->setMinimumWidth(60);
     layout->addWidget(m_speedLabel);
     
+    // Turbo: as many steps as fit in a frame, the speed no longer applies
+    m_turboBtn = new QPushButton("⚡ Turbo");
+    m_turboBtn->setToolTip("Run as fast as possible, redrawing once per frame");
+    m_turboBtn->setCheckable(true);
+    connect(m_turboBtn, &QPushButton::toggled, [this](bool checked) {
+        m_speedSlider->setEnabled(!checked);
+        m_speedLabel->setEnabled(!checked);
+        emit turboToggled(checked);
+    });
+    layout->addWidget(m_turboBtn);
+    
+    layout->addSpacing(30);
+    
+    // Stop time
+    QLabel* stopTitle = new QLabel("Stop at:");
+    layout->addWidget(stopTitle);
+    
+    m_stopTimeSpin = new QSpinBox();
+    m_stopTimeSpin->setRange(0, 1000000000);
+    m_stopTimeSpin->setSpecialValueText("end");
+    m_stopTimeSpin->setToolTip("Pause a run once the simulation reaches this time");
+    connect(m_stopTimeSpin, &QSpinBox::valueChanged, [this](int value) {
+        emit stopTimeChanged(value == 0 ? -1 : value);
+    });
+    layout->addWidget(m_stopTimeSpin);
+    
     layout->addStretch();
 }
 
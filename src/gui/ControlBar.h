@@ -5,6 +5,7 @@
 #include <QPushButton>
 #include <QSlider>
 #include <QLabel>
+#include <QSpinBox>
 #include <QHBoxLayout>
 
 class ControlBar : public QWidget {
@@ -21,6 +22,8 @@ signals:
     void pauseClicked();
     void resetClicked();
     void speedChanged(int msPerStep);
+    void turboToggled(bool enabled);
+    void stopTimeChanged(int time);    // -1: run to the end
     
 private:
     QPushButton* m_stepBtn;
@@ -29,6 +32,8 @@ private:
     QPushButton* m_resetBtn;
     QSlider* m_speedSlider;
     QLabel* m_speedLabel;
+    QPushButton* m_turboBtn;
+    QSpinBox* m_stopTimeSpin;
 };
 
 #endif // CONTROLBAR_H
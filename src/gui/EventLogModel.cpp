@@ -0,0 +1,119 @@
+#include "EventLogModel.h"
+#include <QColor>
+#include <QDateTime>
+#include <algorithm>
+
+namespace {
+QColor typeColor(LogType type) {
+    switch (type) {
+        case LogType::Delivery: return QColor(100, 200, 100);
+        case LogType::Dispatch: return QColor(100, 170, 255);
+        case LogType::Cancel: return QColor(150, 150, 150);
+        case LogType::Maintenance: return QColor(255, 140, 0);
+        default: return QColor();
+    }
+}
+}
+
+EventLogModel::EventLogModel(int capacity, QObject* parent)
+    : QAbstractListModel(parent), m_ring(std::max(1, capacity)),
+      m_firstSeq(0), m_nextSeq(0), m_typeFilter(-1), m_idFilter(-1) {}
+
+void EventLogModel::append(const LogRecord& record) {
+    m_pending.push_back({record, QDateTime::currentMSecsSinceEpoch()});
+}
+
+void EventLogModel::flush() {
+    if (m_pending.empty()) return;
+
+    // A burst larger than the ring only keeps its tail
+    size_t capacity = m_ring.size();
+    size_t skip = m_pending.size() > capacity ? m_pending.size() - capacity : 0;
+    quint64 count = m_pending.size() - skip;
+
+    // Make room: drop the rows of records about to be overwritten
+    quint64 newFirst = std::max(m_firstSeq, m_nextSeq + count > capacity ? m_nextSeq + count - capacity : 0);
+    size_t evicted = 0;
+    while (evicted < m_rows.size() && m_rows[evicted] < newFirst) ++evicted;
+    if (evicted > 0) {
+        beginRemoveRows(QModelIndex(), 0, static_cast<int>(evicted) - 1);
+        m_rows.erase(m_rows.begin(), m_rows.begin() + evicted);
+        endRemoveRows();
+    }
+    m_firstSeq = newFirst;
+
+    std::vector<quint64> accepted;
+    for (size_t i = skip; i < m_pending.size(); ++i) {
+        quint64 seq = m_nextSeq++;
+        Entry& slot = m_ring[seq % capacity];
+        slot = std::move(m_pending[i]);
+        if (accepts(slot)) accepted.push_back(seq);
+    }
+    m_pending.clear();
+
+    if (!accepted.empty()) {
+        int first = static_cast<int>(m_rows.size());
+        beginInsertRows(QModelIndex(), first, first + static_cast<int>(accepted.size()) - 1);
+        m_rows.insert(m_rows.end(), accepted.begin(), accepted.end());
+        endInsertRows();
+    }
+}
+
+void EventLogModel::clear() {
+    beginResetModel();
+    m_rows.clear();
+    m_pending.clear();
+    m_firstSeq = m_nextSeq;
+    endResetModel();
+}
+
+void EventLogModel::setTypeFilter(int type) {
+    if (type == m_typeFilter) return;
+    m_typeFilter = type;
+    refilter();
+}
+
+void EventLogModel::setIdFilter(int id) {
+    if (id == m_idFilter) return;
+    m_idFilter = id;
+    refilter();
+}
+
+bool EventLogModel::accepts(const Entry& entry) const {
+    if (m_typeFilter >= 0 && static_cast<int>(entry.record.type) != m_typeFilter) return false;
+    if (m_idFilter >= 0 && entry.record.orderId != m_idFilter && entry.record.vehicleId != m_idFilter) return false;
+    return true;
+}
+
+void EventLogModel::refilter() {
+    // One pass over the ring; the view keeps its widgets and only re-reads rows
+    beginResetModel();
+    m_rows.clear();
+    for (quint64 seq = m_firstSeq; seq < m_nextSeq; ++seq) {
+        if (accepts(entryAt(seq))) m_rows.push_back(seq);
+    }
+    endResetModel();
+}
+
+int EventLogModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(m_rows.size());
+}
+
+QVariant EventLogModel::data(const QModelIndex& index, int role) const {
+    if (index.row() < 0 || index.row() >= static_cast<int>(m_rows.size())) return QVariant();
+    const Entry& entry = entryAt(m_rows[index.row()]);
+
+    if (role == Qt::DisplayRole) {
+        QString timestamp = QDateTime::fromMSecsSinceEpoch(entry.wallMs).toString("hh:mm:ss");
+        return QString("[%1] %2").arg(timestamp, QString::fromStdString(formatLogRecord(entry.record)));
+    } else if (role == Qt::ForegroundRole) {
+        QColor color = typeColor(entry.record.type);
+        if (color.isValid()) return color;
+    } else if (role == Qt::ToolTipRole) {
+        QString tip = logTypeName(entry.record.type);
+        if (entry.record.orderId >= 0) tip += QString("\nOrder #%1").arg(entry.record.orderId);
+        if (entry.record.vehicleId >= 0) tip += QString("\nVehicle #%1").arg(entry.record.vehicleId);
+        return tip;
+    }
+    return QVariant();
+}
@@ -0,0 +1,57 @@
+#ifndef EVENTLOGMODEL_H
+#define EVENTLOGMODEL_H
+
+#include <QAbstractListModel>
+#include <QString>
+#include <deque>
+#include <vector>
+#include "core/LogRecord.h"
+
+// The event log as a fixed-capacity ring buffer: once full, each new line
+// drops the oldest. append() only queues; flush() moves the queue into the
+// ring with one insert (and at most one removal) notification, so a view
+// refreshed once per frame sees one batch per frame. Rows are the records
+// that pass the current filter, oldest first; a record's text is only built
+// in data(), for rows the view actually shows.
+class EventLogModel : public QAbstractListModel {
+    Q_OBJECT
+
+public:
+    static const int kDefaultCapacity = 10000;
+
+    explicit EventLogModel(int capacity = kDefaultCapacity, QObject* parent = nullptr);
+
+    void append(const LogRecord& record);
+    void flush();
+    void clear();
+    bool hasPending() const { return !m_pending.empty(); }
+
+    // type: a LogType, or -1 for all. id: matches the order or the vehicle
+    // id of a record, -1 for all.
+    void setTypeFilter(int type);
+    void setIdFilter(int id);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+private:
+    struct Entry {
+        LogRecord record;
+        qint64 wallMs;
+    };
+
+    bool accepts(const Entry& entry) const;
+    void refilter();
+    const Entry& entryAt(quint64 seq) const { return m_ring[seq % m_ring.size()]; }
+
+    std::vector<Entry> m_ring;
+    quint64 m_firstSeq;             // oldest record still in the ring
+    quint64 m_nextSeq;              // sequence number of the next record
+    std::deque<quint64> m_rows;     // sequence numbers passing the filter
+    std::vector<Entry> m_pending;
+
+    int m_typeFilter;
+    int m_idFilter;
+};
+
+#endif // EVENTLOGMODEL_H
@@ -1,6 +1,7 @@
 #include "EventLogWidget.h"
+#include <QHBoxLayout>
+#include <QIntValidator>
 #include <QScrollBar>
-#include <QDateTime>
 
 EventLogWidget::EventLogWidget(QWidget* parent)
     : QWidget(parent) {
@@ -14,25 +15,71 @@ EventLogWidget::EventLogWidget(QWidget* parent)
     titleLabel->setFont(titleFont);
     layout->addWidget(titleLabel);
     
-    m_logText = new QTextEdit();
-    m_logText->setReadOnly(true);
-    m_logText->setFont(QFont("Monospace"));
-    layout->addWidget(m_logText);
+    // Filters apply to lines already in the log as well as new ones
+    QHBoxLayout* filterLayout = new QHBoxLayout();
+    m_typeFilter = new QComboBox();
+    m_typeFilter->addItem("All events", -1);
+    for (int type = 0; type < kLogTypeCount; ++type) {
+        m_typeFilter->addItem(logTypeName(static_cast<LogType>(type)), type);
+    }
+    filterLayout->addWidget(m_typeFilter);
+    
+    m_idFilter = new QLineEdit();
+    m_idFilter->setPlaceholderText("Order/vehicle #");
+    m_idFilter->setValidator(new QIntValidator(0, 1000000000, m_idFilter));
+    m_idFilter->setClearButtonEnabled(true);
+    filterLayout->addWidget(m_idFilter);
+    layout->addLayout(filterLayout);
+    
+    // Only the visible rows are laid out and painted
+    m_model = new EventLogModel(EventLogModel::kDefaultCapacity, this);
+    m_view = new QListView();
+    m_view->setModel(m_model);
+    m_view->setUniformItemSizes(true);
+    m_view->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_view->setFont(QFont("Monospace"));
+    layout->addWidget(m_view);
+    
+    m_flushTimer = new QTimer(this);
+    m_flushTimer->setSingleShot(true);
+    m_flushTimer->setInterval(16);
+    connect(m_flushTimer, &QTimer::timeout, this, &EventLogWidget::flushPending);
+    
+    connect(m_typeFilter, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &EventLogWidget::onTypeFilterChanged);
+    connect(m_idFilter, &QLineEdit::textChanged, this, &EventLogWidget::onIdFilterChanged);
 }
 
 void EventLogWidget::addMessage(const QString& message) {
-    QString timestamp = QDateTime::currentDateTime().toString("hh:mm:ss");
-    // Use gray for timestamp, standard text color for message
-    QString formattedMsg = QString("<span style='color: gray;'>[%1]</span> %2").arg(timestamp).arg(message);
-    
-    m_logText->append(formattedMsg);
-    
-    // Auto-scroll to bottom
-    QScrollBar* scrollBar = m_logText->verticalScrollBar();
-    scrollBar->setValue(scrollBar->maximum());
+    addRecord(LogRecord::system(message.toStdString()));
+}
+
+void EventLogWidget::addRecord(const LogRecord& record) {
+    m_model->append(record);
+    if (!m_flushTimer->isActive()) m_flushTimer->start();
+}
+
+void EventLogWidget::flushPending() {
+    // Follow new lines only if the user has not scrolled up
+    QScrollBar* scrollBar = m_view->verticalScrollBar();
+    bool atBottom = scrollBar->value() == scrollBar->maximum();
+    m_model->flush();
+    if (atBottom) m_view->scrollToBottom();
+}
+
+void EventLogWidget::onTypeFilterChanged(int index) {
+    m_model->setTypeFilter(m_typeFilter->itemData(index).toInt());
+    m_view->scrollToBottom();
+}
+
+void EventLogWidget::onIdFilterChanged(const QString& text) {
+    bool ok = false;
+    int id = text.toInt(&ok);
+    m_model->setIdFilter(ok ? id : -1);
+    m_view->scrollToBottom();
 }
 
 void EventLogWidget::clear() {
-    m_logText->clear();
+    m_model->clear();
     addMessage("Event log cleared");
 }
@@ -2,9 +2,13 @@
 #define EVENTLOGWIDGET_H
 
 #include <QWidget>
-#include <QTextEdit>
+#include <QListView>
+#include <QComboBox>
+#include <QLineEdit>
 #include <QVBoxLayout>
 #include <QLabel>
+#include <QTimer>
+#include "EventLogModel.h"
 
 class EventLogWidget : public QWidget {
     Q_OBJECT
@@ -12,11 +16,22 @@ class EventLogWidget : public QWidget {
 public:
     explicit EventLogWidget(QWidget* parent = nullptr);
     
+    // Lines show up at the next frame, all of that frame's lines at once
     void addMessage(const QString& message);
+    void addRecord(const LogRecord& record);
     void clear();
     
+private slots:
+    void flushPending();
+    void onTypeFilterChanged(int index);
+    void onIdFilterChanged(const QString& text);
+    
 private:
-    QTextEdit* m_logText;
+    EventLogModel* m_model;
+    QListView* m_view;
+    QComboBox* m_typeFilter;
+    QLineEdit* m_idFilter;
+    QTimer* m_flushTimer;
 };
 
 #endif // EVENTLOGWIDGET_H
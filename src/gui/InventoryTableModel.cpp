@@ -0,0 +1,89 @@
+#include "InventoryTableModel.h"
+#include <QColor>
+#include <algorithm>
+#include <limits>
+
+InventoryTableModel::InventoryTableModel(QObject* parent)
+    : QAbstractTableModel(parent), m_warehouseId(-1) {}
+
+void InventoryTableModel::update(const Warehouse& warehouse, const std::vector<std::pair<int, int>>& stock) {
+    const auto& inventory = warehouse.getAllInventory();
+
+    if (warehouse.getId() != m_warehouseId || inventory.size() != m_rows.size()) {
+        beginResetModel();
+        m_warehouseId = warehouse.getId();
+        m_rows.assign(inventory.begin(), inventory.end());
+        std::sort(m_rows.begin(), m_rows.end());
+        endResetModel();
+        return;
+    }
+
+    auto first = std::lower_bound(stock.begin(), stock.end(), std::make_pair(m_warehouseId, std::numeric_limits<int>::min()));
+    int firstChanged = -1;
+    int lastChanged = -1;
+    for (auto it = first; it != stock.end() && it->first == m_warehouseId; ++it) {
+        int itemId = it->second;
+        auto row = std::lower_bound(m_rows.begin(), m_rows.end(), std::make_pair(itemId, 0),
+                                    [](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+                                        return a.first < b.first;
+                                    });
+        auto qty = inventory.find(itemId);
+        if (row == m_rows.end() || row->first != itemId || qty == inventory.end()) continue;
+        row->second = qty->second;
+
+        int r = static_cast<int>(row - m_rows.begin());
+        if (r == lastChanged + 1 && firstChanged >= 0) {
+            lastChanged = r;
+            continue;
+        }
+        if (firstChanged >= 0) emit dataChanged(index(firstChanged, 0), index(lastChanged, ColumnCount - 1));
+        firstChanged = lastChanged = r;
+    }
+    if (firstChanged >= 0) emit dataChanged(index(firstChanged, 0), index(lastChanged, ColumnCount - 1));
+}
+
+void InventoryTableModel::clear() {
+    beginResetModel();
+    m_warehouseId = -1;
+    m_rows.clear();
+    endResetModel();
+}
+
+int InventoryTableModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(m_rows.size());
+}
+
+int InventoryTableModel::columnCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant InventoryTableModel::data(const QModelIndex& index, int role) const {
+    if (index.row() < 0 || index.row() >= static_cast<int>(m_rows.size())) return QVariant();
+    int qty = m_rows[index.row()].second;
+
+    if (role == Qt::DisplayRole) {
+        switch (index.column()) {
+            case ItemId: return m_rows[index.row()].first;
+            case Quantity: return qty;
+            case Status:
+                if (qty == 0) return QString("❌ Out of Stock");
+                if (qty < 10) return QString("⚠️ Low Stock");
+                return QString("✅ In Stock");
+        }
+    } else if (role == Qt::BackgroundRole && index.column() == Status) {
+        if (qty == 0) return QColor(255, 100, 100, 100);
+        if (qty < 10) return QColor(255, 200, 100, 100);
+        return QColor(100, 255, 100, 100);
+    }
+    return QVariant();
+}
+
+QVariant InventoryTableModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) return QVariant();
+    switch (section) {
+        case ItemId: return "Item ID";
+        case Quantity: return "Quantity";
+        case Status: return "Status";
+    }
+    return QVariant();
+}
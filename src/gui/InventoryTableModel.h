@@ -0,0 +1,35 @@
+#ifndef INVENTORYTABLEMODEL_H
+#define INVENTORYTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <utility>
+#include <vector>
+#include "models/Warehouse.h"
+
+// One warehouse's stock, one row per item in id order. Rows hold a copy of
+// the quantities, refreshed by update() only for the items the simulator
+// listed as changed (see ChangeSet); the view never reads the warehouse map.
+class InventoryTableModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    enum Column { ItemId, Quantity, Status, ColumnCount };
+
+    explicit InventoryTableModel(QObject* parent = nullptr);
+
+    // stock: sorted (warehouse id, item id) pairs; entries for other
+    // warehouses are skipped
+    void update(const Warehouse& warehouse, const std::vector<std::pair<int, int>>& stock);
+    void clear();
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    int m_warehouseId;
+    std::vector<std::pair<int, int>> m_rows;    // item id, quantity
+};
+
+#endif // INVENTORYTABLEMODEL_H
@@ -1,19 +1,25 @@
 #include "MainWindow.h"
+#include "core/Profiler.h"
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QHBoxLayout>
 #include <QVBoxLayout>
 #include <QAction>
 #include <QMenu>
+#include <algorithm>
 
 MainWindow::MainWindow(QWidget* parent)
-    : QMainWindow(parent) {
+    : QMainWindow(parent), m_rateSteps(0) {
     
     setWindowTitle("Warehouse & Delivery Management System");
     setMinimumSize(1000, 700); // Allow resizing to smaller screens
     
     // Create simulator
-    m_simulator = new Simulator(this);
+    m_simulation = new SimulationWorker(this);
+    
+    m_refreshTimer = new QTimer(this);
+    m_refreshTimer->setSingleShot(true);
+    connect(m_refreshTimer, &QTimer::timeout, this, &MainWindow::updateAllPanels);
     
     // Setup UI components
     setupMenuBar();
@@ -24,7 +30,9 @@ MainWindow::MainWindow(QWidget* parent)
     // Initial status
     m_timeLabel = new QLabel("Time: 0");
     m_statusLabel = new QLabel("Ready - Add orders manually or load a file");
+    m_rateLabel = new QLabel();
     statusBar()->addWidget(m_timeLabel);
+    statusBar()->addWidget(m_rateLabel);
     statusBar()->addPermanentWidget(m_statusLabel);
 }
 
@@ -78,6 +86,18 @@ void MainWindow::setupMenuBar() {
     connect(resetAction, &QAction::triggered, this, &MainWindow::onReset);
     simMenu->addAction(resetAction);
     
+    // View menu
+    QMenu* viewMenu = m_menuBar->addMenu("&View");
+    
+    m_highDensityAction = new QAction("&High-Density Map", this);
+    m_highDensityAction->setCheckable(true);
+    viewMenu->addAction(m_highDensityAction);
+    
+    m_animateMapAction = new QAction("&Animate Map", this);
+    m_animateMapAction->setCheckable(true);
+    m_animateMapAction->setChecked(true);
+    viewMenu->addAction(m_animateMapAction);
+    
     // Help menu
     QMenu* helpMenu = m_menuBar->addMenu("&Help");
     
@@ -103,6 +123,8 @@ void MainWindow::setupToolBar() {
     connect(m_controlBar, &ControlBar::pauseClicked, this, &MainWindow::onPause);
     connect(m_controlBar, &ControlBar::resetClicked, this, &MainWindow::onReset);
     connect(m_controlBar, &ControlBar::speedChanged, this, &MainWindow::onSpeedChanged);
+    connect(m_controlBar, &ControlBar::turboToggled, this, &MainWindow::onTurboToggled);
+    connect(m_controlBar, &ControlBar::stopTimeChanged, this, &MainWindow::onStopTimeChanged);
 }
 
 void MainWindow::setupCentralWidget() {
@@ -118,12 +140,21 @@ void MainWindow::setupCentralWidget() {
     m_ordersPanel = new OrdersPanel(this);
     m_warehousePanel = new WarehousePanel(this);
     m_vehiclePanel = new VehiclePanel(this);
-    m_mapWidget = new MapWidget(m_simulator, this);
+    m_mapWidget = new MapWidget(this);
+    m_statsWidget = new StatsWidget(this);
     
     m_tabWidget->addTab(m_mapWidget, "🗺️ Map"); // Add Map first
     m_tabWidget->addTab(m_ordersPanel, "📦 Orders");
     m_tabWidget->addTab(m_warehousePanel, "🏭 Warehouses");
     m_tabWidget->addTab(m_vehiclePanel, "🚚 Vehicles");
+    m_tabWidget->addTab(m_statsWidget, "📊 Statistics");
+    
+    // Timers are compiled out unless configured with -DWDS_PROFILING=ON
+    m_profilerWidget = nullptr;
+    if (Profiler::kEnabled) {
+        m_profilerWidget = new ProfilerWidget(this);
+        m_tabWidget->addTab(m_profilerWidget, "⏲️ Profiler");
+    }
     
     splitter->addWidget(m_tabWidget);
     
@@ -138,19 +169,20 @@ void MainWindow::setupCentralWidget() {
 }
 
 void MainWindow::setupConnections() {
-    connect(m_simulator, &Simulator::timeAdvanced, this, &MainWindow::onTimeAdvanced);
-    connect(m_simulator, &Simulator::simulationFinished, this, &MainWindow::onSimulationFinished);
-    connect(m_simulator, &Simulator::logMessage, this, &MainWindow::onLogMessage);
-    
-    connect(m_simulator, &Simulator::orderArrived, this, &MainWindow::updateAllPanels);
-    connect(m_simulator, &Simulator::orderDelivered, this, &MainWindow::updateAllPanels);
-    connect(m_simulator, &Simulator::orderCanceled, this, &MainWindow::updateAllPanels);
-    connect(m_simulator, &Simulator::vehicleDispatched, this, &MainWindow::updateAllPanels);
-    connect(m_simulator, &Simulator::inventoryRestocked, this, &MainWindow::updateAllPanels);
+    connect(m_simulation, &SimulationWorker::snapshotReady, this, &MainWindow::scheduleRefresh);
+    connect(m_simulation, &SimulationWorker::loadFinished, this, &MainWindow::onLoadFinished);
+    connect(m_simulation, &SimulationWorker::saveFinished, this, &MainWindow::onSaveFinished);
+    connect(m_simulation, &SimulationWorker::simulationFinished, this, &MainWindow::onSimulationFinished);
+    connect(m_simulation, &SimulationWorker::stopTimeReached, this, &MainWindow::onStopTimeReached);
     
     // Connect order panel signals
     connect(m_ordersPanel, &OrdersPanel::addOrderRequested, this, &MainWindow::onAddOrder);
     connect(m_ordersPanel, &OrdersPanel::removeOrderRequested, this, &MainWindow::onRemoveOrder);
+    
+    // The map also switches on its own when a large fleet is loaded
+    connect(m_highDensityAction, &QAction::toggled, m_mapWidget, &MapWidget::setHighDensity);
+    connect(m_mapWidget, &MapWidget::highDensityChanged, m_highDensityAction, &QAction::setChecked);
+    connect(m_animateMapAction, &QAction::toggled, m_mapWidget, &MapWidget::setAnimated);
 }
 
 void MainWindow::onOpenFile() {
@@ -158,94 +190,161 @@ void MainWindow::onOpenFile() {
         "Text Files (*.txt);;All Files (*)");
     
     if (!filename.isEmpty()) {
-        if (m_simulator->loadFromFile(filename)) {
-            m_statusLabel->setText("Loaded: " + filename);
-            updateAllPanels();
-            m_eventLog->clear();
-            m_eventLog->addMessage("Simulation loaded from: " + filename);
-        } else {
-            QMessageBox::critical(this, "Error", "Failed to load file");
-        }
+        m_simulation->load(filename);
+        m_statusLabel->setText("Loading: " + filename);
+    }
+}
+
+void MainWindow::onLoadFinished(const QString& filename, bool ok, const QString& error) {
+    if (ok) {
+        m_statusLabel->setText("Loaded: " + filename);
+        drainLog();
+        m_eventLog->addMessage("Simulation loaded from: " + filename);
+    } else {
+        m_statusLabel->setText("Ready - Add orders manually or load a file");
+        QMessageBox::critical(this, "Error", "Failed to load file:\n" + error);
     }
 }
 
 void MainWindow::onSaveResults() {
     QString filename = QFileDialog::getSaveFileName(this, "Save Results", "output.txt",
-        "Text Files (*.txt);;All Files (*)");
+        "Text Files (*.txt);;Arrow Files (*.arrow);;All Files (*)");
     
-    if (!filename.isEmpty()) {
-        if (m_simulator->saveResults(filename)) {
-            m_statusLabel->setText("Results saved to: " + filename);
-        } else {
-            QMessageBox::critical(this, "Error", "Failed to save results");
-        }
+    if (!filename.isEmpty()) m_simulation->saveResults(filename);
+}
+
+void MainWindow::onSaveFinished(const QString& filename, bool ok) {
+    if (ok) {
+        m_statusLabel->setText("Results saved to: " + filename);
+    } else {
+        QMessageBox::critical(this, "Error", "Failed to save results");
     }
 }
 
 void MainWindow::onStep() {
-    m_simulator->step();
-    updateAllPanels();
+    m_simulation->step();
 }
 
 void MainWindow::onRun() {
-    m_simulator->run();
+    m_simulation->run();
     m_controlBar->setRunning(true);
     m_statusLabel->setText("Simulation running...");
 }
 
 void MainWindow::onPause() {
-    m_simulator->pause();
+    m_simulation->pause();
     m_controlBar->setRunning(false);
     m_statusLabel->setText("Simulation paused");
 }
 
 void MainWindow::onReset() {
-    m_simulator->reset();
+    m_simulation->reset();
     m_controlBar->setRunning(false);
-    updateAllPanels();
-    m_eventLog->clear();
     m_statusLabel->setText("Simulation reset");
 }
 
 void MainWindow::onSpeedChanged(int speed) {
-    m_simulator->setSpeed(speed);
+    m_simulation->setSpeed(speed);
 }
 
-void MainWindow::onTimeAdvanced(int time) {
-    m_timeLabel->setText(QString("Time: %1").arg(time));
-    updateAllPanels();
+void MainWindow::onTurboToggled(bool enabled) {
+    m_simulation->setTurbo(enabled);
+}
+
+void MainWindow::onStopTimeChanged(int time) {
+    m_simulation->setStopTime(time);
 }
 
 void MainWindow::onSimulationFinished() {
     m_controlBar->setRunning(false);
     m_statusLabel->setText("Simulation finished!");
+    updateAllPanels();
     QMessageBox::information(this, "Complete", "Simulation has finished!");
 }
 
-void MainWindow::onLogMessage(const QString& message) {
-    m_eventLog->addMessage(message);
+void MainWindow::onStopTimeReached(int time) {
+    m_controlBar->setRunning(false);
+    m_statusLabel->setText(QString("Simulation stopped at T=%1").arg(time));
 }
 
 void MainWindow::onAddOrder(int orderId, int dest, int dueBy, bool isVip,
                             const std::vector<std::pair<int, int>>& items) {
-    m_simulator->addManualOrder(orderId, dest, dueBy, isVip, items);
-    updateAllPanels();
+    m_simulation->addManualOrder(orderId, dest, dueBy, isVip, items);
     m_eventLog->addMessage(QString("Manual order #%1 added (%2)")
         .arg(orderId).arg(isVip ? "VIP" : "Standard"));
     m_statusLabel->setText(QString("Added order #%1").arg(orderId));
 }
 
 void MainWindow::onRemoveOrder(int orderId) {
-    m_simulator->cancelOrder(orderId);
-    updateAllPanels();
+    m_simulation->cancelOrder(orderId);
     m_eventLog->addMessage(QString("Order #%1 removed").arg(orderId));
 }
 
+void MainWindow::clearPanels() {
+    // Ids from the previous scenario may be reused for different orders
+    m_ordersPanel->clear();
+    m_warehousePanel->clear();
+    m_vehiclePanel->clear();
+}
+
+void MainWindow::drainLog() {
+    // Cleared when the worker gets to the load or reset, not on the click:
+    // records from steps already in flight are dropped with the old ones
+    if (m_simulation->skipToLastReset()) m_eventLog->clear();
+    LogRecord record;
+    while (m_simulation->popLog(record)) m_eventLog->addRecord(record);
+    long long dropped = m_simulation->takeDroppedLogs();
+    if (dropped > 0) m_eventLog->addMessage(QString("%1 log lines dropped").arg(dropped));
+}
+
+void MainWindow::scheduleRefresh() {
+    if (m_refreshTimer->isActive()) return;
+    
+    // At most one refresh per frame (~60 Hz); the first after a quiet spell
+    // runs as soon as the event loop is free
+    const qint64 frameMs = 16;
+    qint64 elapsed = m_sinceRefresh.isValid() ? m_sinceRefresh.elapsed() : frameMs;
+    m_refreshTimer->start(static_cast<int>(std::max<qint64>(0, frameMs - elapsed)));
+}
+
 void MainWindow::updateAllPanels() {
-    m_ordersPanel->update(m_simulator->getOrders(), 
-                          m_simulator->getVipQueue(),
-                          m_simulator->getStdQueue());
-    m_warehousePanel->update(m_simulator->getWarehouses());
-    m_vehiclePanel->update(m_simulator->getVehicles());
-    m_mapWidget->refresh();
+    WDS_PROFILE_SCOPE(GuiRefresh);
+    m_sinceRefresh.start();
+    drainLog();
+    if (!m_simulation->acquireSnapshot()) return;
+    
+    // Panels keep pointers into the snapshot and acquiring handed the old
+    // one back to the worker: every panel moves to the new one right here
+    const SimSnapshot& snapshot = m_simulation->snapshot();
+    if (snapshot.changes.reset) clearPanels();
+    
+    m_timeLabel->setText(QString("Time: %1").arg(snapshot.time));
+    updateStepRate(snapshot);
+    m_ordersPanel->update(snapshot.orders, snapshot.vipQueue, snapshot.stdQueue);
+    m_warehousePanel->update(snapshot.warehouses, snapshot.changes);
+    m_vehiclePanel->update(snapshot.vehicles, snapshot.changes);
+    m_statsWidget->update(snapshot.stats);
+    m_mapWidget->refresh(snapshot);
+}
+
+void MainWindow::updateStepRate(const SimSnapshot& snapshot) {
+    if (!snapshot.running) {
+        m_rateTimer.invalidate();
+        m_rateLabel->clear();
+        return;
+    }
+    // A reset while running starts the count over
+    if (!m_rateTimer.isValid() || snapshot.steps < m_rateSteps) {
+        m_rateTimer.start();
+        m_rateSteps = snapshot.steps;
+        return;
+    }
+    
+    // Averaged over half a second so single frames don't make it flicker
+    qint64 elapsed = m_rateTimer.elapsed();
+    if (elapsed < 500) return;
+    double rate = (snapshot.steps - m_rateSteps) * 1000.0 / elapsed;
+    m_rateLabel->setText(QString("%1 steps/s").arg(qRound64(rate)));
+    m_rateTimer.start();
+    m_rateSteps = snapshot.steps;
 }
@@ -8,11 +8,15 @@
 #include <QToolBar>
 #include <QSplitter>
 #include <QLabel>
-#include "core/Simulator.h"
+#include <QTimer>
+#include <QElapsedTimer>
+#include "core/SimulationWorker.h"
 #include "OrdersPanel.h"
 #include "WarehousePanel.h"
 #include "VehiclePanel.h"
 #include "MapWidget.h"
+#include "StatsWidget.h"
+#include "ProfilerWidget.h"
 #include "EventLogWidget.h"
 #include "ControlBar.h"
 
@@ -31,12 +35,16 @@ private slots:
     void onPause();
     void onReset();
     void onSpeedChanged(int speed);
-    void onTimeAdvanced(int time);
+    void onTurboToggled(bool enabled);
+    void onStopTimeChanged(int time);
+    void onLoadFinished(const QString& filename, bool ok, const QString& error);
+    void onSaveFinished(const QString& filename, bool ok);
     void onSimulationFinished();
-    void onLogMessage(const QString& message);
+    void onStopTimeReached(int time);
     void onAddOrder(int orderId, int dest, int dueBy, bool isVip, 
                     const std::vector<std::pair<int, int>>& items);
     void onRemoveOrder(int orderId);
+    void scheduleRefresh();
     void updateAllPanels();
     
 private:
@@ -44,13 +52,18 @@ private:
     void setupToolBar();
     void setupCentralWidget();
     void setupConnections();
+    void clearPanels();
+    void drainLog();
+    void updateStepRate(const SimSnapshot& snapshot);
     
-    // Core simulator
-    Simulator* m_simulator;
+    // The simulation runs on its own thread; panels read its snapshots
+    SimulationWorker* m_simulation;
     
     // Menu & Toolbar
     QMenuBar* m_menuBar;
     QToolBar* m_toolBar;
+    QAction* m_highDensityAction;
+    QAction* m_animateMapAction;
     ControlBar* m_controlBar;
     
     // Main panels
@@ -59,13 +72,26 @@ private:
     WarehousePanel* m_warehousePanel;
     VehiclePanel* m_vehiclePanel;
     MapWidget* m_mapWidget;
+    StatsWidget* m_statsWidget;
+    ProfilerWidget* m_profilerWidget;
     
     // Side panel
     EventLogWidget* m_eventLog;
     
+    // A new snapshot only marks the panels dirty; one refresh per frame
+    // takes the latest, however many were published in between
+    QTimer* m_refreshTimer;
+    QElapsedTimer m_sinceRefresh;
+    
+    // Steps per second while running, measured over the snapshots' step
+    // counts so it shows what the worker achieved, not what was drawn
+    QElapsedTimer m_rateTimer;
+    long long m_rateSteps;
+    
     // Status bar labels
     QLabel* m_timeLabel;
     QLabel* m_statusLabel;
+    QLabel* m_rateLabel;
 };
 
 #endif // MAINWINDOW_H
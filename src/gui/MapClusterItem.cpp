@@ -0,0 +1,151 @@
+#include "MapClusterItem.h"
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+namespace {
+const double CLUSTER_PIXELS = 64.0;    // on-screen size of a cluster cell
+const double WAREHOUSE_SIZE = 40.0;
+
+const QColor WAREHOUSE_COLOR(255, 140, 0);
+const QColor ORDER_COLOR(0, 200, 220);
+
+struct Cell {
+    double sumX = 0;
+    double sumY = 0;
+    int nodes = 0;
+    int warehouses = 0;
+    int orders = 0;
+};
+}
+
+MapClusterItem::MapClusterItem(QGraphicsItem* parent)
+    : QGraphicsItem(parent) {
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+}
+
+void MapClusterItem::setNodes(const std::vector<QPointF>& positions, const QRectF& bounds) {
+    prepareGeometryChange();
+    m_bounds = bounds;
+    m_positions = positions;
+    m_warehouseIds.assign(positions.size(), -1);
+    m_orderCounts.assign(positions.size(), 0);
+    m_warehouseNodes.clear();
+}
+
+void MapClusterItem::setWarehouse(int node, int warehouseId) {
+    if (node < 0 || node >= static_cast<int>(m_positions.size())) return;
+    if (m_warehouseIds[node] < 0) m_warehouseNodes.push_back(node);
+    m_warehouseIds[node] = warehouseId;
+    update();
+}
+
+void MapClusterItem::addOrder(int node) {
+    if (node < 0 || node >= static_cast<int>(m_orderCounts.size())) return;
+    ++m_orderCounts[node];
+    update();
+}
+
+void MapClusterItem::removeOrder(int node) {
+    if (node < 0 || node >= static_cast<int>(m_orderCounts.size()) || m_orderCounts[node] == 0) return;
+    --m_orderCounts[node];
+    update();
+}
+
+void MapClusterItem::clearOrders() {
+    std::fill(m_orderCounts.begin(), m_orderCounts.end(), 0);
+    update();
+}
+
+QRectF MapClusterItem::boundingRect() const {
+    // Labels sit above the warehouse markers; glyphs are sized in pixels and
+    // reach furthest past the nodes at the smallest zoom
+    double margin = CLUSTER_PIXELS / MIN_LOD;
+    return m_bounds.adjusted(-margin, -margin, margin, margin);
+}
+
+void MapClusterItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) {
+    Q_UNUSED(widget);
+    QRectF exposed = option->exposedRect.isEmpty() ? boundingRect() : option->exposedRect;
+    double lod = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+    if (lod >= DETAIL_LOD) paintDetail(painter, exposed);
+    else paintClusters(painter, exposed, lod);
+}
+
+void MapClusterItem::paintDetail(QPainter* painter, const QRectF& exposed) {
+    QRectF area = exposed.adjusted(-WAREHOUSE_SIZE, -WAREHOUSE_SIZE, WAREHOUSE_SIZE, WAREHOUSE_SIZE);
+    double half = WAREHOUSE_SIZE / 2;
+
+    painter->setPen(Qt::NoPen);
+    painter->setBrush(WAREHOUSE_COLOR);
+    for (int node : m_warehouseNodes) {
+        const QPointF& pos = m_positions[node];
+        if (area.contains(pos)) painter->drawRect(QRectF(pos.x() - half, pos.y() - half, WAREHOUSE_SIZE, WAREHOUSE_SIZE));
+    }
+
+    painter->setPen(Qt::white);
+    for (int node : m_warehouseNodes) {
+        const QPointF& pos = m_positions[node];
+        if (!area.contains(pos)) continue;
+        painter->drawText(QRectF(pos.x() - half, pos.y() - 2 * half, 2 * WAREHOUSE_SIZE, half),
+                          Qt::AlignLeft | Qt::AlignVCenter, QString("WH %1").arg(m_warehouseIds[node]));
+    }
+}
+
+void MapClusterItem::paintClusters(QPainter* painter, const QRectF& exposed, double lod) {
+    // Power-of-two cells in scene units: stable while panning
+    double cellSize = std::exp2(std::ceil(std::log2(CLUSTER_PIXELS / lod)));
+    QRectF area = exposed.adjusted(-cellSize, -cellSize, cellSize, cellSize);
+
+    std::unordered_map<long long, Cell> cells;
+    for (size_t node = 1; node < m_positions.size(); ++node) {
+        bool warehouse = m_warehouseIds[node] >= 0;
+        if (!warehouse && m_orderCounts[node] == 0) continue;
+        const QPointF& pos = m_positions[node];
+        if (!area.contains(pos)) continue;
+
+        long long cx = static_cast<long long>(std::floor(pos.x() / cellSize));
+        long long cy = static_cast<long long>(std::floor(pos.y() / cellSize));
+        Cell& cell = cells[(cx << 32) ^ (cy & 0xffffffffLL)];
+        cell.sumX += pos.x();
+        cell.sumY += pos.y();
+        ++cell.nodes;
+        if (warehouse) ++cell.warehouses;
+        cell.orders += m_orderCounts[node];
+    }
+
+    // Glyphs keep a fixed size on screen
+    QFont font = painter->font();
+    font.setPixelSize(10);
+    painter->setFont(font);
+    for (const auto& entry : cells) {
+        const Cell& cell = entry.second;
+        painter->save();
+        painter->translate(cell.sumX / cell.nodes, cell.sumY / cell.nodes);
+        painter->scale(1.0 / lod, 1.0 / lod);
+
+        double radius = 0;
+        if (cell.warehouses > 0) {
+            radius = std::min(24.0, 9.0 + 3.0 * std::log2(static_cast<double>(cell.warehouses)));
+            painter->setPen(QPen(Qt::white, 1));
+            painter->setBrush(WAREHOUSE_COLOR);
+            painter->drawEllipse(QPointF(0, 0), radius, radius);
+            painter->drawText(QRectF(-radius, -radius, 2 * radius, 2 * radius), Qt::AlignCenter,
+                              QString::number(cell.warehouses));
+        }
+        if (cell.orders > 0) {
+            QString text = QString::number(cell.orders);
+            double width = 8.0 + 6.0 * text.size();
+            QRectF badge(radius * 0.6, -radius * 0.6 - 14, width, 14);
+            if (radius == 0) badge.moveCenter(QPointF(0, 0));
+            painter->setPen(Qt::NoPen);
+            painter->setBrush(ORDER_COLOR);
+            painter->drawRoundedRect(badge, 7, 7);
+            painter->setPen(Qt::black);
+            painter->drawText(badge, Qt::AlignCenter, text);
+        }
+        painter->restore();
+    }
+}
@@ -0,0 +1,43 @@
+#ifndef MAPCLUSTERITEM_H
+#define MAPCLUSTERITEM_H
+
+#include <QGraphicsItem>
+#include <vector>
+
+// Warehouses and waiting-order counts of every network node, drawn as one
+// item with zoom-dependent level of detail. From DETAIL_LOD up each
+// warehouse gets its own marker and label (orders are left to the per-order
+// items); below it, nodes are binned into screen-sized cells and each cell
+// becomes one glyph carrying its warehouse and order counts. Cells are
+// aligned to a power-of-two grid in scene units so they stay put while
+// panning and only regroup when the zoom crosses a power of two.
+class MapClusterItem : public QGraphicsItem {
+public:
+    static constexpr double DETAIL_LOD = 0.5;
+    static constexpr double MIN_LOD = 0.02;    // furthest the map zooms out
+
+    explicit MapClusterItem(QGraphicsItem* parent = nullptr);
+
+    // positions[node], indexed like the travel matrix; clears order counts
+    void setNodes(const std::vector<QPointF>& positions, const QRectF& bounds);
+    void setWarehouse(int node, int warehouseId);
+
+    void addOrder(int node);
+    void removeOrder(int node);
+    void clearOrders();
+
+    QRectF boundingRect() const override;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
+
+private:
+    void paintDetail(QPainter* painter, const QRectF& exposed);
+    void paintClusters(QPainter* painter, const QRectF& exposed, double lod);
+
+    QRectF m_bounds;
+    std::vector<QPointF> m_positions;
+    std::vector<int> m_warehouseIds;    // per node, -1 if none
+    std::vector<int> m_orderCounts;     // waiting/assigned orders per node
+    std::vector<int> m_warehouseNodes;  // nodes with a warehouse, for the detail pass
+};
+
+#endif // MAPCLUSTERITEM_H
@@ -0,0 +1,210 @@
+#include "MapDensityItem.h"
+#include <QGraphicsSceneHoverEvent>
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include <cmath>
+
+namespace {
+const double VEHICLE_RADIUS = 12.0;
+const double ORDER_HALF = 7.0;
+
+const QColor REFRIGERATED_COLOR(0, 122, 204);
+const QColor NORMAL_COLOR(46, 204, 113);
+}
+
+MapDensityItem::MapDensityItem(const QRectF& bounds, QGraphicsItem* parent)
+    : QGraphicsItem(parent), m_bounds(bounds), m_ordersVisible(true), m_moving(0) {
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+    setAcceptHoverEvents(true);
+}
+
+void MapDensityItem::clear() {
+    m_orderIds.clear();
+    m_orderPos.clear();
+    m_orderVip.clear();
+    m_orderDue.clear();
+    m_orderIndex.clear();
+
+    m_vehicleIds.clear();
+    m_vehiclePos.clear();
+    m_vehicleTarget.clear();
+    m_vehicleFlags.clear();
+    m_vehicleIndex.clear();
+    m_moving = 0;
+
+    setToolTip(QString());
+    update();
+}
+
+void MapDensityItem::setBounds(const QRectF& bounds) {
+    prepareGeometryChange();
+    m_bounds = bounds;
+}
+
+void MapDensityItem::addOrder(int orderId, const QPointF& pos, bool vip, int dueBy) {
+    if (!m_orderIndex.emplace(orderId, m_orderIds.size()).second) return;
+    m_orderIds.push_back(orderId);
+    m_orderPos.push_back(pos);
+    m_orderVip.push_back(vip ? 1 : 0);
+    m_orderDue.push_back(dueBy);
+    update(QRectF(pos.x() - ORDER_HALF, pos.y() - ORDER_HALF, 2 * ORDER_HALF, 2 * ORDER_HALF).adjusted(-1, -1, 1, 1));
+}
+
+void MapDensityItem::removeOrder(int orderId) {
+    auto it = m_orderIndex.find(orderId);
+    if (it == m_orderIndex.end()) return;
+    size_t i = it->second;
+    size_t last = m_orderIds.size() - 1;
+    QPointF pos = m_orderPos[i];
+    m_orderIndex.erase(it);
+
+    if (i != last) {
+        m_orderIds[i] = m_orderIds[last];
+        m_orderPos[i] = m_orderPos[last];
+        m_orderVip[i] = m_orderVip[last];
+        m_orderDue[i] = m_orderDue[last];
+        m_orderIndex[m_orderIds[i]] = i;
+    }
+    m_orderIds.pop_back();
+    m_orderPos.pop_back();
+    m_orderVip.pop_back();
+    m_orderDue.pop_back();
+    update(QRectF(pos.x() - ORDER_HALF, pos.y() - ORDER_HALF, 2 * ORDER_HALF, 2 * ORDER_HALF).adjusted(-1, -1, 1, 1));
+}
+
+void MapDensityItem::addVehicle(int vehicleId, const QPointF& pos, bool refrigerated) {
+    if (!m_vehicleIndex.emplace(vehicleId, m_vehicleIds.size()).second) return;
+    m_vehicleIds.push_back(vehicleId);
+    m_vehiclePos.push_back(pos);
+    m_vehicleTarget.push_back(pos);
+    m_vehicleFlags.push_back(refrigerated ? Refrigerated : 0);
+    update();
+}
+
+void MapDensityItem::setVehicleTarget(int vehicleId, const QPointF& target) {
+    auto it = m_vehicleIndex.find(vehicleId);
+    if (it == m_vehicleIndex.end()) return;
+    size_t i = it->second;
+    m_vehicleTarget[i] = target;
+    if (!(m_vehicleFlags[i] & Moving)) ++m_moving;
+    m_vehicleFlags[i] |= ShowPath | Moving;
+    update();
+}
+
+void MapDensityItem::hidePath(int vehicleId) {
+    auto it = m_vehicleIndex.find(vehicleId);
+    if (it == m_vehicleIndex.end()) return;
+    // Idle vehicles finish the leg they were animating, without a line
+    m_vehicleFlags[it->second] &= ~ShowPath;
+    update();
+}
+
+void MapDensityItem::setOrdersVisible(bool visible) {
+    if (visible == m_ordersVisible) return;
+    m_ordersVisible = visible;
+    update();
+}
+
+void MapDensityItem::animate(double speed) {
+    if (m_moving == 0) return;
+
+    for (size_t i = 0; i < m_vehicleIds.size(); ++i) {
+        if (!(m_vehicleFlags[i] & Moving)) continue;
+        QPointF diff = m_vehicleTarget[i] - m_vehiclePos[i];
+        double dist = std::sqrt(diff.x()*diff.x() + diff.y()*diff.y());
+        if (dist > speed) {
+            m_vehiclePos[i] += diff * (speed / dist);
+        } else {
+            m_vehiclePos[i] = m_vehicleTarget[i];
+            m_vehicleFlags[i] &= ~(ShowPath | Moving);
+            --m_moving;
+        }
+    }
+    update();
+}
+
+QRectF MapDensityItem::boundingRect() const {
+    // Markers are centred on nodes inside the scene; leave room for their size
+    return m_bounds.adjusted(-VEHICLE_RADIUS - 2, -VEHICLE_RADIUS - 2, VEHICLE_RADIUS + 2, VEHICLE_RADIUS + 2);
+}
+
+void MapDensityItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) {
+    Q_UNUSED(widget);
+    QRectF exposed = option->exposedRect.isEmpty() ? boundingRect() : option->exposedRect;
+    QRectF vehicleArea = exposed.adjusted(-VEHICLE_RADIUS - 2, -VEHICLE_RADIUS - 2, VEHICLE_RADIUS + 2, VEHICLE_RADIUS + 2);
+    QRectF orderArea = exposed.adjusted(-ORDER_HALF - 1, -ORDER_HALF - 1, ORDER_HALF + 1, ORDER_HALF + 1);
+
+    // Thousands of small shapes: antialiasing costs more than it shows
+    painter->setRenderHint(QPainter::Antialiasing, false);
+
+    // 1. Paths, one batched call per vehicle type
+    std::vector<QLineF> paths[2];
+    for (size_t i = 0; i < m_vehicleIds.size(); ++i) {
+        if (!(m_vehicleFlags[i] & ShowPath)) continue;
+        QLineF line(m_vehiclePos[i], m_vehicleTarget[i]);
+        if (!QRectF(line.p1(), line.p2()).normalized().intersects(exposed)) continue;
+        paths[(m_vehicleFlags[i] & Refrigerated) ? 1 : 0].push_back(line);
+    }
+    painter->setPen(QPen(NORMAL_COLOR, 2, Qt::DashLine));
+    painter->drawLines(paths[0].data(), static_cast<int>(paths[0].size()));
+    painter->setPen(QPen(REFRIGERATED_COLOR, 2, Qt::DashLine));
+    painter->drawLines(paths[1].data(), static_cast<int>(paths[1].size()));
+
+    // 2. Order markers, VIP and standard batches
+    std::vector<QRectF> markers[2];
+    for (size_t i = 0; i < m_orderIds.size() && m_ordersVisible; ++i) {
+        const QPointF& pos = m_orderPos[i];
+        if (!orderArea.contains(pos)) continue;
+        markers[m_orderVip[i]].emplace_back(pos.x() - ORDER_HALF, pos.y() - ORDER_HALF, 2 * ORDER_HALF, 2 * ORDER_HALF);
+    }
+    painter->setPen(QPen(Qt::white));
+    painter->setBrush(Qt::cyan);
+    painter->drawRects(markers[0].data(), static_cast<int>(markers[0].size()));
+    painter->setBrush(Qt::yellow);
+    painter->drawRects(markers[1].data(), static_cast<int>(markers[1].size()));
+
+    // 3. Vehicles on top; one brush change per type
+    painter->setPen(QPen(Qt::white, 2));
+    for (int refrigerated = 0; refrigerated < 2; ++refrigerated) {
+        painter->setBrush(refrigerated ? REFRIGERATED_COLOR : NORMAL_COLOR);
+        for (size_t i = 0; i < m_vehicleIds.size(); ++i) {
+            if (((m_vehicleFlags[i] & Refrigerated) != 0) != (refrigerated != 0)) continue;
+            const QPointF& pos = m_vehiclePos[i];
+            if (!vehicleArea.contains(pos)) continue;
+            painter->drawEllipse(pos, VEHICLE_RADIUS, VEHICLE_RADIUS);
+        }
+    }
+}
+
+void MapDensityItem::hoverMoveEvent(QGraphicsSceneHoverEvent* event) {
+    // The scene shows this item's tooltip; point it at whatever is under the cursor
+    QString tip;
+    int v = vehicleAt(event->pos());
+    if (v >= 0) {
+        tip = QString("Vehicle #%1").arg(m_vehicleIds[v]);
+    } else if (m_ordersVisible) {
+        int o = orderAt(event->pos());
+        if (o >= 0) tip = QString("Order #%1 (Due: %2)").arg(m_orderIds[o]).arg(m_orderDue[o]);
+    }
+    if (tip != toolTip()) setToolTip(tip);
+    QGraphicsItem::hoverMoveEvent(event);
+}
+
+int MapDensityItem::vehicleAt(const QPointF& pos) const {
+    const double r2 = (VEHICLE_RADIUS + 1) * (VEHICLE_RADIUS + 1);
+    for (size_t i = m_vehicleIds.size(); i-- > 0;) {
+        QPointF d = m_vehiclePos[i] - pos;
+        if (QPointF::dotProduct(d, d) <= r2) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+int MapDensityItem::orderAt(const QPointF& pos) const {
+    for (size_t i = m_orderIds.size(); i-- > 0;) {
+        const QPointF& p = m_orderPos[i];
+        if (std::abs(p.x() - pos.x()) <= ORDER_HALF && std::abs(p.y() - pos.y()) <= ORDER_HALF) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,68 @@
+#ifndef MAPDENSITYITEM_H
+#define MAPDENSITYITEM_H
+
+#include <QGraphicsItem>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Every vehicle, path line and order marker of the map in one item. State is
+// kept in contiguous per-field arrays and drawn in a single paint() pass,
+// skipping whatever lies outside the exposed rect; tooltips come from
+// hit-testing those arrays. Used by MapWidget for large fleets, where one
+// scene item per entity costs more than the drawing itself.
+class MapDensityItem : public QGraphicsItem {
+public:
+    explicit MapDensityItem(const QRectF& bounds, QGraphicsItem* parent = nullptr);
+
+    void clear();
+    void setBounds(const QRectF& bounds);
+
+    // Adds the marker if the order is not shown yet
+    void addOrder(int orderId, const QPointF& pos, bool vip, int dueBy);
+    void removeOrder(int orderId);
+
+    // Adds the vehicle at pos if it is not shown yet
+    void addVehicle(int vehicleId, const QPointF& pos, bool refrigerated);
+    // Starts moving towards target, with a path line
+    void setVehicleTarget(int vehicleId, const QPointF& target);
+    void hidePath(int vehicleId);
+
+    // Order markers are left out when the map shows order clusters instead
+    void setOrdersVisible(bool visible);
+
+    // Moves travelling vehicles by up to speed scene units
+    void animate(double speed);
+
+    QRectF boundingRect() const override;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
+
+protected:
+    void hoverMoveEvent(QGraphicsSceneHoverEvent* event) override;
+
+private:
+    enum VehicleFlag : uint8_t { Refrigerated = 1, ShowPath = 2, Moving = 4 };
+
+    int vehicleAt(const QPointF& pos) const;
+    int orderAt(const QPointF& pos) const;
+
+    QRectF m_bounds;
+    bool m_ordersVisible;
+
+    // Orders; removal swaps the last one into the hole
+    std::vector<int> m_orderIds;
+    std::vector<QPointF> m_orderPos;
+    std::vector<uint8_t> m_orderVip;
+    std::vector<int> m_orderDue;
+    std::unordered_map<int, size_t> m_orderIndex;
+
+    // Vehicles; the fleet only changes on load
+    std::vector<int> m_vehicleIds;
+    std::vector<QPointF> m_vehiclePos;
+    std::vector<QPointF> m_vehicleTarget;
+    std::vector<uint8_t> m_vehicleFlags;
+    std::unordered_map<int, size_t> m_vehicleIndex;
+    size_t m_moving;    // vehicles with the Moving flag
+};
+
+#endif // MAPDENSITYITEM_H
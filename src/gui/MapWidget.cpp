@@ -1,19 +1,28 @@
 #include "MapWidget.h"
 #include <QGraphicsRectItem>
 #include <QGraphicsEllipseItem>
-#include <QGraphicsTextItem>
-#include <QRandomGenerator>
 #include <QBrush>
 #include <QPen>
+#include <QWheelEvent>
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <utility>
 
 // Constants for layout
-const int SCENE_WIDTH = 800;
+const int SCENE_WIDTH = 800;     // minimum; larger networks get more room
 const int SCENE_HEIGHT = 600;
+const int SCENE_MARGIN = 50;
+const double NODE_SPACING = 60;  // typical scene distance between nodes
 const int GRID_SIZE = 50;
 
-MapWidget::MapWidget(Simulator* simulator, QWidget* parent)
-    : QGraphicsView(parent), m_simulator(simulator) {
+// Fleets this large switch to the single-item renderer on load
+const int HIGH_DENSITY_VEHICLES = 2000;
+
+MapWidget::MapWidget(QWidget* parent)
+    : QGraphicsView(parent), m_snapshot(nullptr), m_scene(nullptr), m_animationTimer(nullptr),
+      m_clusters(nullptr), m_orderLayer(nullptr), m_detailed(true), m_animated(true),
+      m_highDensity(false), m_density(nullptr) {
     
     m_scene = new QGraphicsScene(this);
     m_scene->setSceneRect(0, 0, SCENE_WIDTH, SCENE_HEIGHT);
@@ -22,9 +31,23 @@ MapWidget::MapWidget(Simulator* simulator, QWidget* parent)
     // Antialiasing for smoother drawing
     setRenderHint(QPainter::Antialiasing);
     setDragMode(QGraphicsView::ScrollHandDrag);
+    setTransformationAnchor(QGraphicsView::AnchorUnderMouse);
     setBackgroundBrush(QBrush(QColor(30, 30, 30))); // Dark background
     
-    setupScene();
+    m_clusters = new MapClusterItem();
+    m_clusters->setZValue(1);
+    m_scene->addItem(m_clusters);
+    
+    // Parent of the pooled order markers, so a zoom level that shows order
+    // clusters can hide them all at once
+    m_orderLayer = m_scene->addRect(QRectF(), Qt::NoPen);
+    m_orderLayer->setFlag(QGraphicsItem::ItemHasNoContents);
+    m_orderLayer->setZValue(1.5);
+    
+    m_density = new MapDensityItem(m_scene->sceneRect());
+    m_density->setZValue(1.5);
+    m_density->setVisible(false);
+    m_scene->addItem(m_density);
     
     // Animation timer (30 FPS)
     m_animationTimer = new QTimer(this);
@@ -37,170 +60,345 @@ MapWidget::MapWidget(Simulator* simulator, QWidget* parent)
 
 MapWidget::~MapWidget() {}
 
-void MapWidget::setupScene() {
-    drawGrid();
-    
-    // Initialize node positions
-    int rows = SCENE_HEIGHT / 100;
-    int cols = SCENE_WIDTH / 100;
-    
-    // Create random positions for 100 nodes
-    for (int i = 0; i < 100; ++i) {
-        // ... (existing logic for positions is fine, let's just use it)
-        int r = (i / cols) % rows;
-        int c = i % cols;
-        int x = c * 100 + 50 + QRandomGenerator::global()->bounded(-30, 30);
-        int y = r * 100 + 50 + QRandomGenerator::global()->bounded(-30, 30);
-        QPointF pos(x, y);
-        m_nodePositions[i] = pos;
-        
-        // Draw faint "Customer Node" if not a known warehouse (0,1,2 usually)
-        if (i >= 3) {
-            QGraphicsEllipseItem* house = m_scene->addEllipse(0, 0, 6, 6, Qt::NoPen, QBrush(QColor(60, 60, 60)));
-            house->setPos(pos - QPointF(3, 3));
-            house->setZValue(0);
-        }
+void MapWidget::layoutNodes() {
+    // Scenario coordinates, or a layout computed from the travel matrix
+    static const std::vector<std::pair<double, double>> noLayout;
+    const auto& layout = m_snapshot->layout ? *m_snapshot->layout : noLayout;
+    int nodes = std::max<int>(1, static_cast<int>(layout.size()) - 1);
+    
+    double minX = 0, maxX = 0, minY = 0, maxY = 0;
+    for (size_t i = 1; i < layout.size(); ++i) {
+        if (i == 1 || layout[i].first < minX) minX = layout[i].first;
+        if (i == 1 || layout[i].first > maxX) maxX = layout[i].first;
+        if (i == 1 || layout[i].second < minY) minY = layout[i].second;
+        if (i == 1 || layout[i].second > maxY) maxY = layout[i].second;
+    }
+    
+    // Grow the scene with the node count so markers keep their spacing
+    double side = NODE_SPACING * std::sqrt(static_cast<double>(nodes));
+    double width = std::max<double>(SCENE_WIDTH, side * 4 / 3 + 2 * SCENE_MARGIN);
+    double height = std::max<double>(SCENE_HEIGHT, side + 2 * SCENE_MARGIN);
+    double spanX = std::max(maxX - minX, 1e-9);
+    double spanY = std::max(maxY - minY, 1e-9);
+    double scale = std::min((width - 2 * SCENE_MARGIN) / spanX, (height - 2 * SCENE_MARGIN) / spanY);
+    // Centre the drawing
+    double offsetX = (width - spanX * scale) / 2;
+    double offsetY = (height - spanY * scale) / 2;
+    
+    m_nodePositions.assign(layout.size(), QPointF(width / 2, height / 2));
+    for (size_t i = 1; i < layout.size(); ++i) {
+        m_nodePositions[i] = QPointF(offsetX + (layout[i].first - minX) * scale,
+                                     offsetY + (layout[i].second - minY) * scale);
+    }
+    
+    QRectF bounds(0, 0, width, height);
+    m_scene->setSceneRect(bounds);
+    m_density->setBounds(bounds);
+    m_clusters->setNodes(m_nodePositions, bounds);
+    for (const auto& pair : m_snapshot->warehouses) {
+        m_clusters->setWarehouse(pair.second.getLocationNode(), pair.first);
     }
+    
+    // Show a large network whole; small ones keep the 1:1 scale
+    if (width > SCENE_WIDTH || height > SCENE_HEIGHT) fitInView(bounds, Qt::KeepAspectRatio);
+    else resetTransform();
+    updateDetail();
 }
 
-void MapWidget::drawGrid() {
-    QPen gridPen(QColor(60, 60, 60), 1, Qt::DotLine);
-    for (int x = 0; x <= SCENE_WIDTH; x += GRID_SIZE) {
-        m_scene->addLine(x, 0, x, SCENE_HEIGHT, gridPen);
+void MapWidget::drawBackground(QPainter* painter, const QRectF& rect) {
+    QGraphicsView::drawBackground(painter, rect);
+    
+    // Grid lines in the exposed part of the scene only
+    QRectF area = rect.intersected(sceneRect());
+    if (area.isEmpty()) return;
+    double step = GRID_SIZE;
+    double lod = transform().m11();
+    while (step * lod < 8) step *= 2; // Keep zoomed-out grids from turning solid
+    
+    QPen gridPen(QColor(60, 60, 60), 0, Qt::DotLine);
+    painter->setPen(gridPen);
+    for (double x = std::ceil(area.left() / step) * step; x <= area.right(); x += step) {
+        painter->drawLine(QLineF(x, area.top(), x, area.bottom()));
+    }
+    for (double y = std::ceil(area.top() / step) * step; y <= area.bottom(); y += step) {
+        painter->drawLine(QLineF(area.left(), y, area.right(), y));
     }
-    for (int y = 0; y <= SCENE_HEIGHT; y += GRID_SIZE) {
-        m_scene->addLine(0, y, SCENE_WIDTH, y, gridPen);
+}
+
+void MapWidget::wheelEvent(QWheelEvent* event) {
+    double steps = event->angleDelta().y() / 120.0;
+    if (steps == 0) {
+        QGraphicsView::wheelEvent(event);
+        return;
     }
+    double factor = std::pow(1.2, steps);
+    double lod = transform().m11() * factor;
+    if (lod < MapClusterItem::MIN_LOD || lod > 8) return;
+    scale(factor, factor);
+    updateDetail();
+    event->accept();
+}
+
+void MapWidget::updateDetail() {
+    // Individual order markers only where MapClusterItem draws warehouses
+    // one by one; below that the clusters carry the order counts
+    bool detailed = transform().m11() >= MapClusterItem::DETAIL_LOD;
+    if (detailed == m_detailed) return;
+    m_detailed = detailed;
+    m_orderLayer->setVisible(detailed);
+    m_density->setOrdersVisible(detailed);
 }
 
 QPointF MapWidget::getNodePosition(int nodeId) {
-    if (!m_nodePositions.contains(nodeId)) {
-        m_nodePositions[nodeId] = QPointF(SCENE_WIDTH/2, SCENE_HEIGHT/2);
+    if (nodeId < 0 || nodeId >= static_cast<int>(m_nodePositions.size())) {
+        return sceneRect().center();
     }
     return m_nodePositions[nodeId];
 }
 
-void MapWidget::refresh() {
-    const auto& warehouses = m_simulator->getWarehouses();
+void MapWidget::refresh(const SimSnapshot& snapshot) {
+    m_snapshot = &snapshot;
+    const ChangeSet& changes = snapshot.changes;
+    const auto& orders = snapshot.orders;
+    const auto& vehicles = snapshot.vehicles;
     
-    // 1. Draw Warehouses
-    for (const auto& pair : warehouses) {
-        int id = pair.first;
-        const Warehouse& w = pair.second;
+    if (changes.reset) {
+        // 1. Nodes and warehouses only change on load
+        layoutNodes();
         
-        if (!m_warehouseItems.contains(id)) {
-            QPointF pos = getNodePosition(w.getLocationNode());
-            QGraphicsRectItem* rect = m_scene->addRect(0, 0, 40, 40, Qt::NoPen, QBrush(QColor(255, 140, 0)));
-            rect->setPos(pos - QPointF(20, 20));
-            rect->setZValue(1);
-            
-            QGraphicsTextItem* label = m_scene->addText(QString("WH %1").arg(id));
-            label->setDefaultTextColor(Qt::white);
-            label->setPos(pos - QPointF(20, 40));
-            
-            m_warehouseItems[id] = nullptr;
+        bool dense = static_cast<int>(vehicles.size()) >= HIGH_DENSITY_VEHICLES;
+        if (dense != m_highDensity) {
+            setHighDensity(dense);
+            return;
         }
+        rebuild();
+        return;
     }
     
-    // 2. Draw Orders
-    qDeleteAll(m_orderItems);
-    m_orderItems.clear();
+    // 2. Orders: only those the simulator listed
+    for (int oid : changes.orders) {
+        auto it = orders.find(oid);
+        if (it != orders.end()) updateOrder(it->second);
+        else releaseOrder(oid);
+    }
     
-    const auto& orders = m_simulator->getOrders();
-    for (const auto& pair : orders) {
-        const Order& o = pair.second;
-        if (o.getStatus() == OrderStatus::Waiting || o.getStatus() == OrderStatus::Assigned) {
-            QPointF pos = getNodePosition(o.getDestination());
-            
-            // Bigger visual for orders
-            QColor color = (o.getPriorityClass() == PriorityClass::VIP) ? Qt::yellow : Qt::cyan;
-            QGraphicsRectItem* item = m_scene->addRect(0, 0, 14, 14, QPen(Qt::white), QBrush(color));
-            item->setPos(pos - QPointF(7, 7));
-            item->setZValue(1.5);
-            item->setToolTip(QString("Order #%1 (Due: %2)").arg(o.getId()).arg(o.getDueBy()));
-            
-            m_orderItems[o.getId()] = item;
-        }
+    // 3. Vehicles & Paths
+    for (int vid : changes.vehicles) {
+        auto it = vehicles.find(vid);
+        if (it != vehicles.end()) updateVehicle(it->second);
+    }
+    if (!m_animated) moveVehicles(std::numeric_limits<double>::infinity());
+}
+
+void MapWidget::setHighDensity(bool enabled) {
+    if (enabled == m_highDensity) return;
+    m_highDensity = enabled;
+    m_density->setVisible(enabled);
+    rebuild();
+    emit highDensityChanged(enabled);
+}
+
+void MapWidget::rebuild() {
+    releaseAll();
+    if (!m_snapshot) return;
+    for (const auto& pair : m_snapshot->orders) updateOrder(pair.second);
+    for (const auto& pair : m_snapshot->vehicles) updateVehicle(pair.second);
+    if (!m_animated) moveVehicles(std::numeric_limits<double>::infinity());
+}
+
+void MapWidget::setAnimated(bool enabled) {
+    if (enabled == m_animated) return;
+    m_animated = enabled;
+    if (enabled) {
+        m_animationTimer->start(33);
+    } else {
+        m_animationTimer->stop();
+        moveVehicles(std::numeric_limits<double>::infinity());
+    }
+}
+
+int MapWidget::vehicleTarget(const Vehicle& v) {
+    const auto& warehouses = m_snapshot->warehouses;
+    if (v.getStatus() == VehicleStatus::Outbound) return v.getCurrentDestination();
+    if (v.getStatus() == VehicleStatus::Returning && warehouses.count(v.getHomeWarehouse())) {
+        return warehouses.at(v.getHomeWarehouse()).getLocationNode();
+    }
+    return -1;
+}
+
+QPointF MapWidget::vehicleHome(const Vehicle& v) {
+    const auto& warehouses = m_snapshot->warehouses;
+    int startNodeId = 0;
+    if (warehouses.count(v.getHomeWarehouse())) startNodeId = warehouses.at(v.getHomeWarehouse()).getLocationNode();
+    return getNodePosition(startNodeId);
+}
+
+void MapWidget::updateOrder(const Order& o) {
+    if (o.getStatus() != OrderStatus::Waiting && o.getStatus() != OrderStatus::Assigned) {
+        releaseOrder(o.getId());
+        return;
     }
+    // A marker only depends on fields fixed at arrival
+    if (m_orderNodes.contains(o.getId())) return;
+    m_orderNodes.insert(o.getId(), o.getDestination());
+    m_clusters->addOrder(o.getDestination());
     
-    // 3. Update Vehicles & Paths
-    const auto& vehicles = m_simulator->getVehicles();
-    for (const auto& pair : vehicles) {
-        int vid = pair.first;
-        const Vehicle& v = pair.second;
-        
-        // Ensure vehicle item exists
-        if (!m_vehicleItems.contains(vid)) {
-            QColor vColor = v.isRefrigerated() ? QColor(0, 122, 204) : QColor(46, 204, 113); // Brighter Blue/Green
-            QGraphicsEllipseItem* item = m_scene->addEllipse(0, 0, 24, 24, QPen(Qt::white, 2), QBrush(vColor));
-            item->setZValue(3);
-            item->setToolTip(QString("Vehicle #%1").arg(vid));
-            
-            m_vehicleItems[vid] = item;
+    if (m_highDensity) {
+        m_density->addOrder(o.getId(), getNodePosition(o.getDestination()),
+                            o.getPriorityClass() == PriorityClass::VIP, o.getDueBy());
+        return;
+    }
+    
+    QGraphicsRectItem* item;
+    if (!m_orderPool.isEmpty()) {
+        item = m_orderPool.takeLast();
+    } else {
+        item = new QGraphicsRectItem(0, 0, 14, 14, m_orderLayer);
+        item->setPen(QPen(Qt::white));
+    }
+    
+    // Bigger visual for orders
+    QColor color = (o.getPriorityClass() == PriorityClass::VIP) ? Qt::yellow : Qt::cyan;
+    item->setBrush(QBrush(color));
+    item->setPos(getNodePosition(o.getDestination()) - QPointF(7, 7));
+    item->setToolTip(QString("Order #%1 (Due: %2)").arg(o.getId()).arg(o.getDueBy()));
+    item->setVisible(true);
+    
+    m_orderItems.insert(o.getId(), item);
+}
+
+void MapWidget::releaseOrder(int orderId) {
+    auto node = m_orderNodes.constFind(orderId);
+    if (node == m_orderNodes.constEnd()) return;
+    m_clusters->removeOrder(*node);
+    m_orderNodes.erase(node);
+    
+    if (m_highDensity) {
+        m_density->removeOrder(orderId);
+        return;
+    }
+    QGraphicsRectItem* item = m_orderItems.take(orderId);
+    if (!item) return;
+    item->setVisible(false);
+    m_orderPool.append(item);
+}
+
+void MapWidget::updateVehicle(const Vehicle& v) {
+    int vid = v.getId();
+    int targetNode = vehicleTarget(v);
+    
+    if (m_highDensity) {
+        m_density->addVehicle(vid, vehicleHome(v), v.isRefrigerated());
+        if (targetNode != -1) m_density->setVehicleTarget(vid, getNodePosition(targetNode));
+        else m_density->hidePath(vid);
+        return;
+    }
+    
+    // Ensure vehicle item exists
+    auto existing = m_vehicleItems.find(vid);
+    if (existing == m_vehicleItems.end()) {
+        QColor vColor = v.isRefrigerated() ? QColor(0, 122, 204) : QColor(46, 204, 113); // Brighter Blue/Green
+        VehicleGraphics graphics;
+        if (!m_vehiclePool.isEmpty()) {
+            graphics = m_vehiclePool.takeLast();
+        } else {
+            graphics.marker = m_scene->addEllipse(0, 0, 24, 24, QPen(Qt::white, 2));
+            graphics.marker->setZValue(3);
             
             // Path Line
-            QGraphicsLineItem* line = m_scene->addLine(0,0,0,0, QPen(vColor, 2, Qt::DashLine));
-            line->setZValue(0.5);
-            line->setVisible(false);
-            m_pathLines[vid] = line;
-            
-            // Init state
-            int startNodeId = 0;
-            if (warehouses.count(v.getHomeWarehouse())) startNodeId = warehouses.at(v.getHomeWarehouse()).getLocationNode();
-            m_vehicleStates[vid].currentPos = getNodePosition(startNodeId);
-            m_vehicleStates[vid].targetPos = m_vehicleStates[vid].currentPos;
-            item->setPos(m_vehicleStates[vid].currentPos - QPointF(12, 12));
+            graphics.path = m_scene->addLine(0, 0, 0, 0);
+            graphics.path->setZValue(0.5);
         }
+        graphics.marker->setBrush(QBrush(vColor));
+        graphics.marker->setToolTip(QString("Vehicle #%1").arg(vid));
+        graphics.marker->setVisible(true);
+        graphics.path->setPen(QPen(vColor, 2, Qt::DashLine));
+        graphics.path->setVisible(false);
         
-        // Update Target logic
-        int targetNode = -1;
-        if (v.getStatus() == VehicleStatus::Outbound) targetNode = v.getCurrentDestination();
-        else if (v.getStatus() == VehicleStatus::Returning) {
-            if (warehouses.count(v.getHomeWarehouse())) targetNode = warehouses.at(v.getHomeWarehouse()).getLocationNode();
-        }
+        // Init state
+        VehicleAnimState& state = m_vehicleStates[vid];
+        state.currentPos = vehicleHome(v);
+        state.targetPos = state.currentPos;
+        graphics.marker->setPos(state.currentPos - QPointF(12, 12));
         
-        if (targetNode != -1) {
-            m_vehicleStates[vid].targetPos = getNodePosition(targetNode);
-            m_pathLines[vid]->setLine(QLineF(m_vehicleStates[vid].currentPos, m_vehicleStates[vid].targetPos));
-            m_pathLines[vid]->setVisible(true);
-        } else {
-            m_pathLines[vid]->setVisible(false);
-            // If idle, target = current
-            VehicleAnimState& state = m_vehicleStates[vid];
-            QPointF diff = state.targetPos - state.currentPos;
-            if (QPointF::dotProduct(diff, diff) < 1.0) {
-                 // Already at target, stay there?
-                 // Usually vehicle stays at node unless moving.
-                 // We rely on simulator logic mainly.
-            }
-        }
+        existing = m_vehicleItems.insert(vid, graphics);
+    }
+    
+    // Update Target logic
+    QGraphicsLineItem* line = existing->path;
+    if (targetNode != -1) {
+        VehicleAnimState& state = m_vehicleStates[vid];
+        state.targetPos = getNodePosition(targetNode);
+        line->setLine(QLineF(state.currentPos, state.targetPos));
+        line->setVisible(true);
+        m_movingVehicles.insert(vid);
+    } else {
+        // Idle vehicles finish the leg they were animating, without a line
+        line->setVisible(false);
     }
 }
 
+void MapWidget::releaseAll() {
+    // Ids from the previous scenario may be reused for different entities
+    for (QGraphicsRectItem* item : std::as_const(m_orderItems)) {
+        item->setVisible(false);
+        m_orderPool.append(item);
+    }
+    m_orderItems.clear();
+    m_orderNodes.clear();
+    m_clusters->clearOrders();
+    
+    for (const VehicleGraphics& graphics : std::as_const(m_vehicleItems)) {
+        graphics.marker->setVisible(false);
+        graphics.path->setVisible(false);
+        m_vehiclePool.append(graphics);
+    }
+    m_vehicleItems.clear();
+    m_vehicleStates.clear();
+    m_movingVehicles.clear();
+    
+    m_density->clear();
+}
+
 void MapWidget::updateAnimation() {
-    for (auto it = m_vehicleItems.begin(); it != m_vehicleItems.end(); ++it) {
-        int vid = it.key();
-        QGraphicsItem* item = it.value();
+    moveVehicles(4.0);
+}
+
+void MapWidget::moveVehicles(double speed) {
+    if (m_highDensity) {
+        m_density->animate(speed);
+        return;
+    }
+    for (auto it = m_movingVehicles.begin(); it != m_movingVehicles.end();) {
+        int vid = *it;
+        auto graphics = m_vehicleItems.constFind(vid);
+        if (graphics == m_vehicleItems.constEnd()) {
+            it = m_movingVehicles.erase(it);
+            continue;
+        }
         VehicleAnimState& state = m_vehicleStates[vid];
-        QGraphicsLineItem* line = m_pathLines.value(vid);
+        QGraphicsLineItem* line = graphics->path;
         
         QPointF diff = state.targetPos - state.currentPos;
         double dist = std::sqrt(diff.x()*diff.x() + diff.y()*diff.y());
         
-        if (dist > 1.0) {
-            double speed = 4.0; 
+        bool arrived = false;
+        if (dist > speed) {
             QPointF move = diff * (speed / dist);
             state.currentPos += move;
             
             // Update line to start from current pos
-            if (line && line->isVisible()) {
+            if (line->isVisible()) {
                 line->setLine(QLineF(state.currentPos, state.targetPos));
             }
         } else {
             state.currentPos = state.targetPos;
-            if (line) line->setVisible(false); // Hide line when arrived
+            line->setVisible(false); // Hide line when arrived
+            arrived = true;
         }
         
-        item->setPos(state.currentPos - QPointF(12, 12));
+        graphics->marker->setPos(state.currentPos - QPointF(12, 12));
+        if (arrived) it = m_movingVehicles.erase(it);
+        else ++it;
     }
 }
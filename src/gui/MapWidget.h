@@ -4,9 +4,15 @@
 #include <QGraphicsView>
 #include <QGraphicsScene>
 #include <QGraphicsItem>
+#include <QHash>
 #include <QMap>
+#include <QSet>
 #include <QTimer>
-#include "../core/Simulator.h"
+#include <QVector>
+#include "../core/ChangeSet.h"
+#include "../core/SimulationWorker.h"
+#include "MapClusterItem.h"
+#include "MapDensityItem.h"
 
 // Forward declarations
 class WarehouseItem;
@@ -17,37 +23,82 @@ class MapWidget : public QGraphicsView {
     Q_OBJECT
 
 public:
-    explicit MapWidget(Simulator* simulator, QWidget* parent = nullptr);
+    explicit MapWidget(QWidget* parent = nullptr);
     ~MapWidget();
 
-    void refresh(); // Full refresh of the map state
+    // Applies the snapshot's changes; a reset re-reads everything. The map
+    // keeps reading the snapshot (e.g. on a mode switch) until the next call.
+    void refresh(const SimSnapshot& snapshot);
+
+    bool isHighDensity() const { return m_highDensity; }
+    bool isAnimated() const { return m_animated; }
+
+protected:
+    void drawBackground(QPainter* painter, const QRectF& rect) override;
+    void wheelEvent(QWheelEvent* event) override;
 
 public slots:
     void updateAnimation(); // Called periodically for smooth movement
+    void setHighDensity(bool enabled);
+    // Off: vehicles jump to where they are heading on each refresh
+    void setAnimated(bool enabled);
+
+signals:
+    void highDensityChanged(bool enabled);
 
 private:
-    void setupScene();
-    void drawGrid();
+    // A vehicle's marker and the line to where it is heading
+    struct VehicleGraphics {
+        QGraphicsEllipseItem* marker;
+        QGraphicsLineItem* path;
+    };
+
+    void layoutNodes();
+    void updateDetail();
     QPointF getNodePosition(int nodeId);
 
-    Simulator* m_simulator;
+    void updateOrder(const Order& order);
+    void updateVehicle(const Vehicle& vehicle);
+    void releaseOrder(int orderId);
+    void releaseAll();
+    void rebuild();
+    int vehicleTarget(const Vehicle& vehicle);
+    QPointF vehicleHome(const Vehicle& vehicle);
+    void moveVehicles(double speed);
+
+    const SimSnapshot* m_snapshot;    // null until the first refresh
     QGraphicsScene* m_scene;
     QTimer* m_animationTimer;
 
     // Cache
-    QMap<int, QPointF> m_nodePositions;
-    QMap<int, QGraphicsPixmapItem*> m_warehouseItems;
-    QMap<int, QGraphicsEllipseItem*> m_vehicleItems;
-    QMap<int, QGraphicsRectItem*> m_orderItems;
-    QMap<int, QGraphicsLineItem*> m_pathLines; // Lines showing vehicle paths
-    QMap<int, QGraphicsEllipseItem*> m_customerNodes; // Faint dots for all nodes
+    std::vector<QPointF> m_nodePositions;   // scene position per node
+    QHash<int, int> m_orderNodes;           // shown order -> destination node
+    QHash<int, QGraphicsRectItem*> m_orderItems;
+    QHash<int, VehicleGraphics> m_vehicleItems;
+    
+    // Warehouses and, when zoomed out, order counts (level of detail)
+    MapClusterItem* m_clusters;
+    QGraphicsRectItem* m_orderLayer;
+    bool m_detailed;
+
+    // Items no longer shown stay in the scene, hidden, until reused; this
+    // keeps the scene index from being rebuilt as orders come and go
+    QVector<QGraphicsRectItem*> m_orderPool;
+    QVector<VehicleGraphics> m_vehiclePool;
     
     // Animation state
     struct VehicleAnimState {
         QPointF currentPos;
         QPointF targetPos;
     };
-    QMap<int, VehicleAnimState> m_vehicleStates;
+    QHash<int, VehicleAnimState> m_vehicleStates;
+    QSet<int> m_movingVehicles; // Only these are stepped by updateAnimation
+    bool m_animated;
+
+    // High-density mode draws orders and vehicles through this one item
+    // instead of the pooled per-entity items above
+    bool m_highDensity;
+    MapDensityItem* m_density;
 };
 
 #endif // MAPWIDGET_H
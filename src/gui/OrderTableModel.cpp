@@ -0,0 +1,208 @@
+#include "OrderTableModel.h"
+#include <QColor>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+QColor statusColor(OrderStatus status) {
+    switch (status) {
+        case OrderStatus::Waiting: return QColor(255, 200, 100, 100);
+        case OrderStatus::Assigned: return QColor(100, 150, 255, 100);
+        case OrderStatus::InTransit: return QColor(100, 200, 255, 100);
+        case OrderStatus::Delivered: return QColor(100, 255, 100, 100);
+        case OrderStatus::Canceled: return QColor(150, 150, 150, 100);
+        default: return QColor(50, 50, 50, 100);
+    }
+}
+}
+
+OrderTableModel::OrderTableModel(QObject* parent)
+    : QAbstractTableModel(parent), m_orders(nullptr) {}
+
+void OrderTableModel::update(const std::map<int, Order>& orders, const std::vector<int>& queue) {
+    m_orders = &orders;
+
+    // Remove rows whose order left the queue, one contiguous run at a time
+    std::unordered_set<int> queued(queue.begin(), queue.end());
+    if (queued.size() != queue.size()) {
+        // Duplicate ids cannot be diffed row by row
+        beginResetModel();
+        m_rows.clear();
+        endResetModel();
+    }
+    for (int end = static_cast<int>(m_rows.size()); end > 0;) {
+        if (queued.count(m_rows[end - 1].orderId)) {
+            --end;
+            continue;
+        }
+        int begin = end - 1;
+        while (begin > 0 && !queued.count(m_rows[begin - 1].orderId)) --begin;
+        beginRemoveRows(QModelIndex(), begin, end - 1);
+        m_rows.erase(m_rows.begin() + begin, m_rows.begin() + end);
+        endRemoveRows();
+        end = begin;
+    }
+
+    // The VIP queue is re-sorted every step, so the remaining rows may need
+    // to move before new ones can be slotted in
+    std::unordered_set<int> shown;
+    for (const Row& row : m_rows) shown.insert(row.orderId);
+    size_t matched = 0;
+    bool inOrder = true;
+    for (int oid : queue) {
+        if (!shown.count(oid)) continue;
+        if (m_rows[matched++].orderId != oid) {
+            inOrder = false;
+            break;
+        }
+    }
+    if (!inOrder) reorder(queue);
+
+    // Insert orders that joined the queue, one contiguous run at a time
+    size_t row = 0;
+    for (size_t i = 0; i < queue.size();) {
+        if (shown.count(queue[i])) {
+            ++row;
+            ++i;
+            continue;
+        }
+        size_t j = i;
+        while (j < queue.size() && !shown.count(queue[j])) ++j;
+        beginInsertRows(QModelIndex(), static_cast<int>(row), static_cast<int>(row + (j - i) - 1));
+        std::vector<Row> added;
+        added.reserve(j - i);
+        for (size_t k = i; k < j; ++k) {
+            auto it = orders.find(queue[k]);
+            added.push_back({queue[k], it != orders.end() ? it->second.getStatus() : OrderStatus::Waiting,
+                             it != orders.end() ? it->second.getBlockedAttempts() : 0});
+        }
+        m_rows.insert(m_rows.begin() + row, added.begin(), added.end());
+        endInsertRows();
+        row += j - i;
+        i = j;
+    }
+
+    // Report rows whose status or blocking changed, again in runs
+    int count = static_cast<int>(m_rows.size());
+    int firstChanged = -1;
+    for (int r = 0; r <= count; ++r) {
+        bool changed = r < count && refreshRow(r);
+        if (changed && firstChanged < 0) {
+            firstChanged = r;
+        } else if (!changed && firstChanged >= 0) {
+            emit dataChanged(index(firstChanged, 0), index(r - 1, ColumnCount - 1));
+            firstChanged = -1;
+        }
+    }
+}
+
+void OrderTableModel::reorder(const std::vector<int>& queue) {
+    emit layoutAboutToBeChanged();
+
+    std::unordered_map<int, Row> byId;
+    for (const Row& row : m_rows) byId.emplace(row.orderId, row);
+    std::vector<int> oldIds;
+    oldIds.reserve(m_rows.size());
+    for (const Row& row : m_rows) oldIds.push_back(row.orderId);
+
+    std::unordered_map<int, int> newRow;
+    m_rows.clear();
+    for (int oid : queue) {
+        auto it = byId.find(oid);
+        if (it == byId.end()) continue;
+        newRow[oid] = static_cast<int>(m_rows.size());
+        m_rows.push_back(it->second);
+    }
+
+    // Keep the selection on the same orders
+    QModelIndexList from = persistentIndexList();
+    QModelIndexList to;
+    for (const QModelIndex& index : from) {
+        to.append(this->index(newRow[oldIds[index.row()]], index.column()));
+    }
+    changePersistentIndexList(from, to);
+
+    emit layoutChanged();
+}
+
+void OrderTableModel::clear() {
+    beginResetModel();
+    m_rows.clear();
+    m_orders = nullptr;
+    endResetModel();
+}
+
+bool OrderTableModel::refreshRow(int row) {
+    const Order* order = orderAt(row);
+    if (!order) return false;
+    Row& shown = m_rows[row];
+    if (shown.status == order->getStatus() && shown.blockedAttempts == order->getBlockedAttempts()) {
+        return false;
+    }
+    shown.status = order->getStatus();
+    shown.blockedAttempts = order->getBlockedAttempts();
+    return true;
+}
+
+const Order* OrderTableModel::orderAt(int row) const {
+    if (!m_orders || row < 0 || row >= static_cast<int>(m_rows.size())) return nullptr;
+    auto it = m_orders->find(m_rows[row].orderId);
+    return it != m_orders->end() ? &it->second : nullptr;
+}
+
+int OrderTableModel::orderIdAt(int row) const {
+    return row >= 0 && row < static_cast<int>(m_rows.size()) ? m_rows[row].orderId : -1;
+}
+
+int OrderTableModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(m_rows.size());
+}
+
+int OrderTableModel::columnCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant OrderTableModel::data(const QModelIndex& index, int role) const {
+    const Order* order = orderAt(index.row());
+    if (!order) return QVariant();
+
+    if (role == Qt::DisplayRole) {
+        switch (index.column()) {
+            case Id: return order->getId();
+            case RequestTime: return order->getRequestTime();
+            case DueBy: return order->getDueBy() > 0 ? QString::number(order->getDueBy()) : QString("N/A");
+            case Destination: return order->getDestination();
+            case Items: return order->getTotalQuantity();
+            case Value: return QString::number(order->getValue(), 'f', 1);
+            case Status: return QString::fromStdString(order->getStatusString());
+            case Blocked:
+                // Last reason the scheduler skipped it, and how many attempts failed
+                if (order->getLastBlockReason() == BlockReason::None) return QString();
+                return QString("%1 (%2)").arg(QString::fromStdString(order->getBlockReasonString()))
+                                         .arg(order->getBlockedAttempts());
+        }
+    } else if (role == Qt::BackgroundRole && index.column() == Status) {
+        return statusColor(order->getStatus());
+    } else if (role == Qt::ToolTipRole && index.column() == Blocked) {
+        return QString("No stock: %1\nNo vehicle: %2\nCapacity: %3")
+            .arg(order->getBlockCount(BlockReason::NoStock))
+            .arg(order->getBlockCount(BlockReason::NoVehicle))
+            .arg(order->getBlockCount(BlockReason::NoCapacity));
+    }
+    return QVariant();
+}
+
+QVariant OrderTableModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) return QVariant();
+    switch (section) {
+        case Id: return "ID";
+        case RequestTime: return "Request Time";
+        case DueBy: return "Due By";
+        case Destination: return "Destination";
+        case Items: return "Items";
+        case Value: return "Value";
+        case Status: return "Status";
+        case Blocked: return "Blocked";
+    }
+    return QVariant();
+}
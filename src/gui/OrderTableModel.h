@@ -0,0 +1,46 @@
+#ifndef ORDERTABLEMODEL_H
+#define ORDERTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <map>
+#include <vector>
+#include "models/Order.h"
+
+// One scheduler queue as a table. update() diffs the queue against the rows
+// already shown and emits only the inserts, removals and changed rows; cells
+// are built in data(), so only rows the view paints cost anything.
+class OrderTableModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    enum Column { Id, RequestTime, DueBy, Destination, Items, Value, Status, Blocked, ColumnCount };
+
+    explicit OrderTableModel(QObject* parent = nullptr);
+
+    void update(const std::map<int, Order>& orders, const std::vector<int>& queue);
+    void clear();
+
+    int orderIdAt(int row) const;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    // What a row showed when last reported, to detect changes
+    struct Row {
+        int orderId;
+        OrderStatus status;
+        int blockedAttempts;
+    };
+
+    const Order* orderAt(int row) const;
+    bool refreshRow(int row);
+    void reorder(const std::vector<int>& queue);
+
+    const std::map<int, Order>* m_orders;
+    std::vector<Row> m_rows;
+};
+
+#endif // ORDERTABLEMODEL_H
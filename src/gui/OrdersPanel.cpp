@@ -25,8 +25,9 @@ OrdersPanel::OrdersPanel(QWidget* parent)
     m_vipLabel->setFont(headerFont);
     vipLayout->addWidget(m_vipLabel);
     
-    m_vipTable = new QTableWidget();
-    setupTable(m_vipTable);
+    m_vipTable = new QTableView();
+    m_vipModel = new OrderTableModel(this);
+    setupTable(m_vipTable, m_vipModel);
     vipLayout->addWidget(m_vipTable);
     
     tableSplitter->addWidget(vipWidget);
@@ -40,8 +41,9 @@ OrdersPanel::OrdersPanel(QWidget* parent)
     m_stdLabel->setFont(headerFont);
     stdLayout->addWidget(m_stdLabel);
     
-    m_stdTable = new QTableWidget();
-    setupTable(m_stdTable);
+    m_stdTable = new QTableView();
+    m_stdModel = new OrderTableModel(this);
+    setupTable(m_stdTable, m_stdModel);
     stdLayout->addWidget(m_stdTable);
     
     tableSplitter->addWidget(stdWidget);
@@ -54,11 +56,12 @@ OrdersPanel::OrdersPanel(QWidget* parent)
     mainLayout->addWidget(m_inputGroup, 1);
 }
 
-void OrdersPanel::setupTable(QTableWidget* table) {
-    table->setColumnCount(7);
-    table->setHorizontalHeaderLabels({"ID", "Request Time", "Due By", "Destination", "Items", "Value", "Status"});
+void OrdersPanel::setupTable(QTableView* table, OrderTableModel* model) {
+    table->setModel(model);
     table->horizontalHeader()->setStretchLastSection(true);
     table->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    // Size columns from the visible rows only; queues can hold 100k orders
+    table->horizontalHeader()->setResizeContentsPrecision(0);
     table->setSelectionBehavior(QAbstractItemView::SelectRows);
     table->setEditTriggers(QAbstractItemView::NoEditTriggers);
     table->setAlternatingRowColors(true);
@@ -182,44 +185,13 @@ void OrdersPanel::update(const std::map<int, Order>& orders,
     m_vipLabel->setText(QString("⭐ VIP Orders Queue (%1)").arg(vipQueue.size()));
     m_stdLabel->setText(QString("📦 Standard Orders Queue (%1)").arg(stdQueue.size()));
     
-    populateTable(m_vipTable, vipQueue, orders);
-    populateTable(m_stdTable, stdQueue, orders);
+    m_vipModel->update(orders, vipQueue);
+    m_stdModel->update(orders, stdQueue);
 }
 
-void OrdersPanel::populateTable(QTableWidget* table, const std::vector<int>& orderIds,
-                                 const std::map<int, Order>& orders) {
-    table->setRowCount(0);
-    
-    for (int oid : orderIds) {
-        auto it = orders.find(oid);
-        if (it == orders.end()) continue;
-        
-        const Order& order = it->second;
-        int row = table->rowCount();
-        table->insertRow(row);
-        
-        table->setItem(row, 0, new QTableWidgetItem(QString::number(order.getId())));
-        table->setItem(row, 1, new QTableWidgetItem(QString::number(order.getRequestTime())));
-        table->setItem(row, 2, new QTableWidgetItem(order.getDueBy() > 0 ? QString::number(order.getDueBy()) : "N/A"));
-        table->setItem(row, 3, new QTableWidgetItem(QString::number(order.getDestination())));
-        table->setItem(row, 4, new QTableWidgetItem(QString::number(order.getTotalQuantity())));
-        table->setItem(row, 5, new QTableWidgetItem(QString::number(order.getValue(), 'f', 1)));
-        
-        QTableWidgetItem* statusItem = new QTableWidgetItem(QString::fromStdString(order.getStatusString()));
-        statusItem->setBackground(getStatusColor(order.getStatus()));
-        table->setItem(row, 6, statusItem);
-    }
-}
-
-QColor OrdersPanel::getStatusColor(OrderStatus status) {
-    switch (status) {
-        case OrderStatus::Waiting: return QColor(255, 200, 100, 100);
-        case OrderStatus::Assigned: return QColor(100, 150, 255, 100);
-        case OrderStatus::InTransit: return QColor(100, 200, 255, 100);
-        case OrderStatus::Delivered: return QColor(100, 255, 100, 100);
-        case OrderStatus::Canceled: return QColor(150, 150, 150, 100);
-        default: return QColor(50, 50, 50, 100);
-    }
+void OrdersPanel::clear() {
+    m_vipModel->clear();
+    m_stdModel->clear();
 }
 
 void OrdersPanel::onAddItemClicked() {
@@ -280,17 +252,15 @@ void OrdersPanel::onAddOrderClicked() {
 
 void OrdersPanel::onRemoveOrderClicked() {
     // Check VIP table first
-    int row = m_vipTable->currentRow();
-    if (row >= 0) {
-        int orderId = m_vipTable->item(row, 0)->text().toInt();
+    int orderId = m_vipModel->orderIdAt(m_vipTable->currentIndex().row());
+    if (orderId >= 0) {
         emit removeOrderRequested(orderId);
         return;
     }
     
     // Check Standard table
-    row = m_stdTable->currentRow();
-    if (row >= 0) {
-        int orderId = m_stdTable->item(row, 0)->text().toInt();
+    orderId = m_stdModel->orderIdAt(m_stdTable->currentIndex().row());
+    if (orderId >= 0) {
         emit removeOrderRequested(orderId);
         return;
     }
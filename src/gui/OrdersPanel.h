@@ -3,6 +3,7 @@
 
 #include <QWidget>
 #include <QTableWidget>
+#include <QTableView>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QLabel>
@@ -16,6 +17,7 @@
 #include <map>
 #include <vector>
 #include "models/Order.h"
+#include "OrderTableModel.h"
 
 class OrdersPanel : public QWidget {
     Q_OBJECT
@@ -26,6 +28,8 @@ public:
     void update(const std::map<int, Order>& orders,
                 const std::vector<int>& vipQueue,
                 const std::vector<int>& stdQueue);
+    // Drops all rows, e.g. when a new scenario reuses order ids
+    void clear();
     
 signals:
     void addOrderRequested(int orderId, int dest, int dueBy, bool isVip,
@@ -39,18 +43,17 @@ private slots:
     void onRemoveItemClicked();
     
 private:
-    void setupTable(QTableWidget* table);
+    void setupTable(QTableView* table, OrderTableModel* model);
     void setupInputForm();
-    void populateTable(QTableWidget* table, const std::vector<int>& orderIds,
-                       const std::map<int, Order>& orders);
-    QColor getStatusColor(OrderStatus status);
     void updateItemsList();
     
     // Tables
     QLabel* m_vipLabel;
     QLabel* m_stdLabel;
-    QTableWidget* m_vipTable;
-    QTableWidget* m_stdTable;
+    QTableView* m_vipTable;
+    QTableView* m_stdTable;
+    OrderTableModel* m_vipModel;
+    OrderTableModel* m_stdModel;
     
     // Input form
     QGroupBox* m_inputGroup;
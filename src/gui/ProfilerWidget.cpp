@@ -0,0 +1,57 @@
+#include "ProfilerWidget.h"
+#include <QHeaderView>
+#include <QLabel>
+#include <QPushButton>
+#include <QVBoxLayout>
+#include "core/Profiler.h"
+
+ProfilerWidget::ProfilerWidget(QWidget* parent)
+    : QWidget(parent) {
+    
+    QVBoxLayout* mainLayout = new QVBoxLayout(this);
+    mainLayout->setContentsMargins(10, 10, 10, 10);
+    
+    QLabel* titleLabel = new QLabel("⏲️ Hot-Path Timers");
+    QFont titleFont = titleLabel->font();
+    titleFont.setPointSize(14);
+    titleFont.setBold(true);
+    titleLabel->setFont(titleFont);
+    mainLayout->addWidget(titleLabel);
+    
+    m_table = new QTableWidget(Profiler::ZoneCount, 4, this);
+    m_table->setHorizontalHeaderLabels({"Zone", "Calls", "Total ms", "ns/call"});
+    m_table->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    m_table->verticalHeader()->setVisible(false);
+    m_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    for (int zone = 0; zone < Profiler::ZoneCount; ++zone) {
+        m_table->setItem(zone, 0, new QTableWidgetItem(Profiler::zoneName(zone)));
+        for (int col = 1; col < 4; ++col) {
+            QTableWidgetItem* item = new QTableWidgetItem();
+            item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+            m_table->setItem(zone, col, item);
+        }
+    }
+    mainLayout->addWidget(m_table);
+    
+    QPushButton* resetButton = new QPushButton("Reset");
+    connect(resetButton, &QPushButton::clicked, this, [this]() {
+        Profiler::reset();
+        refresh();
+    });
+    mainLayout->addWidget(resetButton, 0, Qt::AlignRight);
+    
+    m_timer = new QTimer(this);
+    connect(m_timer, &QTimer::timeout, this, &ProfilerWidget::refresh);
+    m_timer->start(500);
+}
+
+void ProfilerWidget::refresh() {
+    if (!isVisible()) return;
+    for (int zone = 0; zone < Profiler::ZoneCount; ++zone) {
+        Profiler::ZoneStats stats = Profiler::get(static_cast<Profiler::Zone>(zone));
+        m_table->item(zone, 1)->setText(QString::number(stats.calls));
+        m_table->item(zone, 2)->setText(QString::number(stats.ns / 1e6, 'f', 1));
+        m_table->item(zone, 3)->setText(stats.calls > 0
+            ? QString::number(static_cast<double>(stats.ns) / stats.calls, 'f', 0) : QString("-"));
+    }
+}
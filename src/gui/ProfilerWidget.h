@@ -0,0 +1,23 @@
+#ifndef PROFILERWIDGET_H
+#define PROFILERWIDGET_H
+
+#include <QWidget>
+#include <QTableWidget>
+#include <QTimer>
+
+// Live view of the Profiler zones; only shown in WDS_PROFILING builds
+class ProfilerWidget : public QWidget {
+    Q_OBJECT
+    
+public:
+    explicit ProfilerWidget(QWidget* parent = nullptr);
+    
+public slots:
+    void refresh();
+    
+private:
+    QTableWidget* m_table;
+    QTimer* m_timer;
+};
+
+#endif // PROFILERWIDGET_H
@@ -67,6 +67,42 @@ StatsWidget::StatsWidget(QWidget* parent)
     progressLayout->addWidget(m_deliveryProgress);
     
     mainLayout->addWidget(progressFrame);
+    
+    // Latency percentiles of delivered orders
+    QFrame* latencyFrame = new QFrame();
+    latencyFrame->setStyleSheet("QFrame { background-color: #16213e; border-radius: 10px; padding: 15px; }");
+    QGridLayout* latencyLayout = new QGridLayout(latencyFrame);
+    
+    QLabel* latencyTitle = new QLabel("⏳ Latency Percentiles");
+    latencyTitle->setStyleSheet("font-size: 14px; color: #87ceeb;");
+    latencyLayout->addWidget(latencyTitle, 0, 0);
+    
+    const char* headers[4] = {"p50", "p90", "p99", "p99.9"};
+    for (int i = 0; i < 4; ++i) {
+        QLabel* header = new QLabel(headers[i]);
+        header->setStyleSheet("font-size: 12px; color: #87ceeb;");
+        header->setAlignment(Qt::AlignRight);
+        latencyLayout->addWidget(header, 0, i + 1);
+    }
+    
+    int row = 1;
+    for (int m = 0; m < LatencyStats::MetricCount; ++m) {
+        for (int c = 0; c < LatencyStats::ClassCount; ++c, ++row) {
+            QLabel* name = new QLabel(QString("%1 %2")
+                .arg(LatencyStats::metricName(m)).arg(LatencyStats::className(c)));
+            name->setStyleSheet("font-size: 12px; color: #e0e0e0;");
+            latencyLayout->addWidget(name, row, 0);
+            for (int i = 0; i < 4; ++i) {
+                QLabel* value = new QLabel("0");
+                value->setStyleSheet("font-size: 12px; font-weight: bold; color: #e0e0e0;");
+                value->setAlignment(Qt::AlignRight);
+                latencyLayout->addWidget(value, row, i + 1);
+                m_latencyLabels[m][c][i] = value;
+            }
+        }
+    }
+    
+    mainLayout->addWidget(latencyFrame);
     mainLayout->addStretch();
 }
 
@@ -84,4 +120,14 @@ void StatsWidget::update(const Simulator::Statistics& stats) {
     int progress = stats.totalOrders > 0 
         ? (stats.deliveredOrders * 100 / stats.totalOrders) : 0;
     m_deliveryProgress->setValue(progress);
+    
+    for (int m = 0; m < LatencyStats::MetricCount; ++m) {
+        for (int c = 0; c < LatencyStats::ClassCount; ++c) {
+            const LatencyPercentiles& p = stats.latency.values[m][c];
+            int values[4] = {p.p50, p.p90, p.p99, p.p999};
+            for (int i = 0; i < 4; ++i) {
+                m_latencyLabels[m][c][i]->setText(QString::number(values[i]));
+            }
+        }
+    }
 }
@@ -28,6 +28,9 @@ private:
     QLabel* m_avgTransitValue;
     QLabel* m_onTimeValue;
     QProgressBar* m_deliveryProgress;
+    
+    // p50, p90, p99, p99.9 per latency metric and priority class
+    QLabel* m_latencyLabels[LatencyStats::MetricCount][LatencyStats::ClassCount][4];
 };
 
 #endif // STATSWIDGET_H
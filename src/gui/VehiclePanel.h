@@ -2,11 +2,12 @@
 #define VEHICLEPANEL_H
 
 #include <QWidget>
-#include <QGridLayout>
-#include <QFrame>
+#include <QTableView>
 #include <QLabel>
 #include <map>
+#include "core/ChangeSet.h"
 #include "models/Vehicle.h"
+#include "VehicleTableModel.h"
 
 class VehiclePanel : public QWidget {
     Q_OBJECT
@@ -14,15 +15,13 @@ class VehiclePanel : public QWidget {
 public:
     explicit VehiclePanel(QWidget* parent = nullptr);
     
-    void update(const std::map<int, Vehicle>& vehicles);
+    void update(const std::map<int, Vehicle>& vehicles, const ChangeSet& changes);
+    void clear();
     
 private:
-    QWidget* createVehicleCard(const Vehicle& vehicle);
-    QColor getStatusColor(VehicleStatus status);
-    QString getStatusIcon(VehicleStatus status);
-    
-    QGridLayout* m_gridLayout;
-    QWidget* m_scrollContent;
+    QLabel* m_titleLabel;
+    QTableView* m_table;
+    VehicleTableModel* m_model;
 };
 
 #endif // VEHICLEPANEL_H
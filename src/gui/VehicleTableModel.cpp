@@ -0,0 +1,114 @@
+#include "VehicleTableModel.h"
+#include <QColor>
+#include <algorithm>
+
+namespace {
+QString statusIcon(VehicleStatus status) {
+    switch (status) {
+        case VehicleStatus::Available: return "✅";
+        case VehicleStatus::Outbound: return "🚚";
+        case VehicleStatus::Returning: return "↩️";
+        case VehicleStatus::Maintenance: return "🔧";
+        default: return "❓";
+    }
+}
+}
+
+VehicleTableModel::VehicleTableModel(QObject* parent)
+    : QAbstractTableModel(parent), m_vehicles(nullptr) {}
+
+void VehicleTableModel::update(const std::map<int, Vehicle>& vehicles, const std::vector<int>& changed) {
+    m_vehicles = &vehicles;
+
+    if (vehicles.size() != m_rows.size()) {
+        beginResetModel();
+        m_rows.clear();
+        m_rows.reserve(vehicles.size());
+        for (const auto& [vid, vehicle] : vehicles) m_rows.push_back(vid);
+        endResetModel();
+        return;
+    }
+
+    // Rows are in id order, so each changed vehicle is a binary search away;
+    // neighbouring rows are reported together
+    int firstChanged = -1;
+    int lastChanged = -1;
+    for (int vid : changed) {
+        auto it = std::lower_bound(m_rows.begin(), m_rows.end(), vid);
+        if (it == m_rows.end() || *it != vid) continue;
+        int row = static_cast<int>(it - m_rows.begin());
+        if (row == lastChanged + 1 && firstChanged >= 0) {
+            lastChanged = row;
+            continue;
+        }
+        if (firstChanged >= 0) emit dataChanged(index(firstChanged, 0), index(lastChanged, ColumnCount - 1));
+        firstChanged = lastChanged = row;
+    }
+    if (firstChanged >= 0) emit dataChanged(index(firstChanged, 0), index(lastChanged, ColumnCount - 1));
+}
+
+void VehicleTableModel::clear() {
+    beginResetModel();
+    m_rows.clear();
+    m_vehicles = nullptr;
+    endResetModel();
+}
+
+const Vehicle* VehicleTableModel::vehicleAt(int row) const {
+    if (!m_vehicles || row < 0 || row >= static_cast<int>(m_rows.size())) return nullptr;
+    auto it = m_vehicles->find(m_rows[row]);
+    return it != m_vehicles->end() ? &it->second : nullptr;
+}
+
+int VehicleTableModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(m_rows.size());
+}
+
+int VehicleTableModel::columnCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant VehicleTableModel::data(const QModelIndex& index, int role) const {
+    const Vehicle* vehicle = vehicleAt(index.row());
+    if (!vehicle) return QVariant();
+
+    if (role == Qt::DisplayRole) {
+        switch (index.column()) {
+            case Id: return QString("%1 #%2").arg(vehicle->isRefrigerated() ? "❄️" : "📦").arg(vehicle->getId());
+            case Type: return QString::fromStdString(vehicle->getTypeString());
+            case Status:
+                return QString("%1 %2").arg(statusIcon(vehicle->getStatus()))
+                                       .arg(QString::fromStdString(vehicle->getStatusString()));
+            case Capacity: return vehicle->getCapacity();
+            case Speed: return vehicle->getSpeed();
+            case Home: return QString("Warehouse #%1").arg(vehicle->getHomeWarehouse());
+            case Orders: {
+                QString orders;
+                for (int oid : vehicle->getAssignedOrders()) orders += QString("#%1 ").arg(oid);
+                return orders.trimmed();
+            }
+        }
+    } else if (role == Qt::ForegroundRole && index.column() == Status) {
+        switch (vehicle->getStatus()) {
+            case VehicleStatus::Available: return QColor(Qt::darkGreen);
+            case VehicleStatus::Maintenance: return QColor(Qt::darkRed);
+            case VehicleStatus::Returning: return QColor(255, 140, 0); // Dark Orange
+            default: break;
+        }
+    }
+    return QVariant();
+}
+
+QVariant VehicleTableModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) return QVariant();
+    switch (section) {
+        case Id: return "Vehicle";
+        case Type: return "Type";
+        case Status: return "Status";
+        case Capacity: return "Capacity";
+        case Speed: return "Speed";
+        case Home: return "Home";
+        case Orders: return "Orders";
+    }
+    return QVariant();
+}
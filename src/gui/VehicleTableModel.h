@@ -0,0 +1,36 @@
+#ifndef VEHICLETABLEMODEL_H
+#define VEHICLETABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <map>
+#include <vector>
+#include "models/Vehicle.h"
+
+// The fleet as a table, one row per vehicle in id order. The fleet itself
+// only changes on load, so update() normally just reports the vehicles the
+// simulator listed as changed (see ChangeSet).
+class VehicleTableModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    enum Column { Id, Type, Status, Capacity, Speed, Home, Orders, ColumnCount };
+
+    explicit VehicleTableModel(QObject* parent = nullptr);
+
+    // changed: sorted vehicle ids
+    void update(const std::map<int, Vehicle>& vehicles, const std::vector<int>& changed);
+    void clear();
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    const Vehicle* vehicleAt(int row) const;
+
+    const std::map<int, Vehicle>* m_vehicles;
+    std::vector<int> m_rows;    // vehicle ids, ascending
+};
+
+#endif // VEHICLETABLEMODEL_H
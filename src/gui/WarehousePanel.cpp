@@ -33,9 +33,9 @@ WarehousePanel::WarehousePanel(QWidget* parent)
     mainLayout->addLayout(headerLayout);
     
     // Inventory table
-    m_inventoryTable = new QTableWidget();
-    m_inventoryTable->setColumnCount(3);
-    m_inventoryTable->setHorizontalHeaderLabels({"Item ID", "Quantity", "Status"});
+    m_inventoryModel = new InventoryTableModel(this);
+    m_inventoryTable = new QTableView();
+    m_inventoryTable->setModel(m_inventoryModel);
     m_inventoryTable->horizontalHeader()->setStretchLastSection(true);
     m_inventoryTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
     m_inventoryTable->setSelectionBehavior(QAbstractItemView::SelectRows);
@@ -49,11 +49,11 @@ WarehousePanel::WarehousePanel(QWidget* parent)
     mainLayout->addWidget(m_summaryLabel);
 }
 
-void WarehousePanel::update(const std::map<int, Warehouse>& warehouses) {
+void WarehousePanel::update(const std::map<int, Warehouse>& warehouses, const ChangeSet& changes) {
     m_warehousesPtr = &warehouses;
     
     // Update selector if needed
-    if (m_warehouseSelector->count() != static_cast<int>(warehouses.size())) {
+    if (changes.reset || m_warehouseSelector->count() != static_cast<int>(warehouses.size())) {
         m_warehouseSelector->blockSignals(true);
         m_warehouseSelector->clear();
         for (const auto& [wid, wh] : warehouses) {
@@ -66,54 +66,28 @@ void WarehousePanel::update(const std::map<int, Warehouse>& warehouses) {
     if (!warehouses.empty()) {
         int currentWid = m_warehouseSelector->currentData().toInt();
         if (warehouses.find(currentWid) != warehouses.end()) {
-            updateInventoryTable(warehouses.at(currentWid));
+            updateInventoryTable(warehouses.at(currentWid), changes);
         }
     }
 }
 
+void WarehousePanel::clear() {
+    m_warehousesPtr = nullptr;
+    m_inventoryModel->clear();
+}
+
 void WarehousePanel::onWarehouseSelected(int index) {
     if (m_warehousesPtr == nullptr || index < 0) return;
     
     int wid = m_warehouseSelector->itemData(index).toInt();
     auto it = m_warehousesPtr->find(wid);
     if (it != m_warehousesPtr->end()) {
-        updateInventoryTable(it->second);
+        updateInventoryTable(it->second, ChangeSet());
     }
 }
 
-void WarehousePanel::updateInventoryTable(const Warehouse& warehouse) {
-    m_inventoryTable->setRowCount(0);
-    
-    const auto& inventory = warehouse.getAllInventory();
-    int totalItems = 0;
-    
-    for (const auto& [itemId, qty] : inventory) {
-        int row = m_inventoryTable->rowCount();
-        m_inventoryTable->insertRow(row);
-        
-        m_inventoryTable->setItem(row, 0, new QTableWidgetItem(QString::number(itemId)));
-        m_inventoryTable->setItem(row, 1, new QTableWidgetItem(QString::number(qty)));
-        
-        QString status;
-        QColor bgColor;
-        if (qty == 0) {
-            status = "❌ Out of Stock";
-            bgColor = QColor(255, 100, 100, 100);
-        } else if (qty < 10) {
-            status = "⚠️ Low Stock";
-            bgColor = QColor(255, 200, 100, 100);
-        } else {
-            status = "✅ In Stock";
-            bgColor = QColor(100, 255, 100, 100);
-        }
-        
-        QTableWidgetItem* statusItem = new QTableWidgetItem(status);
-        statusItem->setBackground(bgColor);
-        m_inventoryTable->setItem(row, 2, statusItem);
-        
-        totalItems += qty;
-    }
-    
+void WarehousePanel::updateInventoryTable(const Warehouse& warehouse, const ChangeSet& changes) {
+    m_inventoryModel->update(warehouse, changes.stock);
     m_summaryLabel->setText(QString("Total Items in Warehouse #%1: %2")
-        .arg(warehouse.getId()).arg(totalItems));
+        .arg(warehouse.getId()).arg(warehouse.getTotalItems()));
 }
@@ -2,12 +2,14 @@
 #define WAREHOUSEPANEL_H
 
 #include <QWidget>
-#include <QTableWidget>
+#include <QTableView>
 #include <QComboBox>
 #include <QVBoxLayout>
 #include <QLabel>
 #include <map>
+#include "core/ChangeSet.h"
 #include "models/Warehouse.h"
+#include "InventoryTableModel.h"
 
 class WarehousePanel : public QWidget {
     Q_OBJECT
@@ -15,19 +17,21 @@ class WarehousePanel : public QWidget {
 public:
     explicit WarehousePanel(QWidget* parent = nullptr);
     
-    void update(const std::map<int, Warehouse>& warehouses);
+    void update(const std::map<int, Warehouse>& warehouses, const ChangeSet& changes);
+    void clear();
     
 private slots:
     void onWarehouseSelected(int index);
     
 private:
-    void updateInventoryTable(const Warehouse& warehouse);
+    void updateInventoryTable(const Warehouse& warehouse, const ChangeSet& changes);
     
     const std::map<int, Warehouse>* m_warehousesPtr;
     
     QLabel* m_titleLabel;
     QComboBox* m_warehouseSelector;
-    QTableWidget* m_inventoryTable;
+    QTableView* m_inventoryTable;
+    InventoryTableModel* m_inventoryModel;
     QLabel* m_summaryLabel;
 };
 
@@ -0,0 +1,236 @@
+#include "BinaryScenario.h"
+
+namespace {
+const size_t kWriteBufferSize = 1 << 20;
+
+uint64_t load64(const unsigned char* p) {
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; --i) v = (v << 8) | p[i];
+    return v;
+}
+
+void store32(unsigned char* p, uint32_t v) {
+    for (int i = 0; i < 4; ++i) p[i] = static_cast<unsigned char>(v >> (8 * i));
+}
+
+void store64(unsigned char* p, uint64_t v) {
+    for (int i = 0; i < 8; ++i) p[i] = static_cast<unsigned char>(v >> (8 * i));
+}
+}
+
+namespace BinaryScenario {
+
+void Checksum::update(const char* data, size_t size) {
+    auto p = reinterpret_cast<const unsigned char*>(data);
+    m_length += size;
+
+    if (m_pending > 0) {
+        while (m_pending < 8 && size > 0) {
+            m_tail[m_pending++] = *p++;
+            --size;
+        }
+        if (m_pending < 8) return;
+        m_hash = mix(m_hash, load64(m_tail));
+        m_pending = 0;
+    }
+    for (; size >= 8; p += 8, size -= 8) {
+        m_hash = mix(m_hash, load64(p));
+    }
+    std::memcpy(m_tail, p, size);
+    m_pending = size;
+}
+
+uint64_t Checksum::value() const {
+    uint64_t h = m_hash;
+    if (m_pending > 0) {
+        unsigned char last[8] = {};
+        std::memcpy(last, m_tail, m_pending);
+        h = mix(h, load64(last));
+    }
+    return mix(h, m_length);
+}
+
+} // namespace BinaryScenario
+
+BinaryScenarioWriter::BinaryScenarioWriter()
+    : m_file(nullptr), m_buffer(kWriteBufferSize), m_used(0), m_payloadBytes(0),
+      m_eventsStart(0), m_eventCount(0), m_header{0, 0, 0}, m_flags(0),
+      m_prevTimestamp(0), m_prevOrderId(0) {}
+
+BinaryScenarioWriter::~BinaryScenarioWriter() {
+    close();
+}
+
+bool BinaryScenarioWriter::open(const std::string& filename) {
+    close();
+    m_file = std::fopen(filename.c_str(), "wb");
+    if (!m_file) {
+        m_error = "Could not open file for writing: " + filename;
+        return false;
+    }
+    // Placeholder; the real header is written by close()
+    char header[BinaryScenario::kHeaderSize] = {};
+    std::fwrite(header, 1, sizeof(header), m_file);
+
+    m_used = 0;
+    m_checksum = BinaryScenario::Checksum();
+    m_payloadBytes = 0;
+    m_eventsStart = 0;
+    m_eventCount = 0;
+    m_flags = 0;
+    m_prevTimestamp = 0;
+    m_prevOrderId = 0;
+    return true;
+}
+
+bool BinaryScenarioWriter::close() {
+    if (!m_file) return true;
+    flush();
+    if (m_eventsStart == 0) m_eventsStart = m_payloadBytes;
+
+    unsigned char header[BinaryScenario::kHeaderSize] = {};
+    std::memcpy(header, BinaryScenario::kMagic, sizeof(BinaryScenario::kMagic));
+    store32(header + 8, BinaryScenario::kVersion);
+    store32(header + 12, static_cast<uint32_t>(BinaryScenario::kHeaderSize));
+    store32(header + 16, static_cast<uint32_t>(m_header[0]));
+    store32(header + 20, static_cast<uint32_t>(m_header[1]));
+    store32(header + 24, static_cast<uint32_t>(m_header[2]));
+    store32(header + 28, m_flags);
+    store64(header + 32, m_eventCount);
+    store64(header + 40, m_payloadBytes - m_eventsStart);
+    store64(header + 48, m_payloadBytes);
+    store64(header + 56, m_checksum.value());
+
+    bool ok = std::fseek(m_file, 0, SEEK_SET) == 0 &&
+              std::fwrite(header, 1, sizeof(header), m_file) == sizeof(header);
+    ok = std::ferror(m_file) == 0 && ok;
+    ok = (std::fclose(m_file) == 0) && ok;
+    m_file = nullptr;
+    if (!ok) m_error = "Write error while closing scenario file";
+    return ok;
+}
+
+void BinaryScenarioWriter::flush() {
+    if (m_file && m_used > 0) {
+        std::fwrite(m_buffer.data(), 1, m_used, m_file);
+        m_checksum.update(m_buffer.data(), m_used);
+        m_payloadBytes += m_used;
+    }
+    m_used = 0;
+}
+
+void BinaryScenarioWriter::putI32(int value) {
+    if (m_used + 4 > m_buffer.size()) flush();
+    store32(reinterpret_cast<unsigned char*>(m_buffer.data() + m_used), static_cast<uint32_t>(value));
+    m_used += 4;
+}
+
+void BinaryScenarioWriter::putF64(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    putI32(static_cast<int>(static_cast<uint32_t>(bits)));
+    putI32(static_cast<int>(static_cast<uint32_t>(bits >> 32)));
+}
+
+void BinaryScenarioWriter::putVarint(uint64_t value) {
+    if (m_used + 10 > m_buffer.size()) flush();
+    while (value >= 0x80) {
+        m_buffer[m_used++] = static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    m_buffer[m_used++] = static_cast<char>(value);
+}
+
+void BinaryScenarioWriter::putByte(uint8_t value) {
+    if (m_used + 1 > m_buffer.size()) flush();
+    m_buffer[m_used++] = static_cast<char>(value);
+}
+
+void BinaryScenarioWriter::writeHeader(int numWarehouses, int numItems, int numVehicles) {
+    m_header[0] = numWarehouses;
+    m_header[1] = numItems;
+    m_header[2] = numVehicles;
+}
+
+void BinaryScenarioWriter::writeTravelRow(const std::vector<int>& row) {
+    for (int t : row) putI32(t);
+}
+
+void BinaryScenarioWriter::writeVehicle(int id, VehicleType type, int speed, int capacity, int homeWarehouse) {
+    putI32(id);
+    putI32(type == VehicleType::Refrigerated ? 1 : 0);
+    putI32(speed);
+    putI32(capacity);
+    putI32(homeWarehouse);
+}
+
+void BinaryScenarioWriter::writeWarehouse(int wid, const std::vector<int>& inventory) {
+    putI32(wid);
+    for (int qty : inventory) putI32(qty);
+}
+
+void BinaryScenarioWriter::writeNodeCoords(const std::vector<std::pair<double, double>>& coords) {
+    m_flags |= BinaryScenario::kFlagCoords;
+    for (int node = 1; node <= m_header[0]; ++node) {
+        std::pair<double, double> pos = node < static_cast<int>(coords.size()) ? coords[node]
+                                                                              : std::make_pair(0.0, 0.0);
+        putF64(pos.first);
+        putF64(pos.second);
+    }
+}
+
+void BinaryScenarioWriter::beginEvents(long long) {
+    // The header records the number of events actually written
+    m_eventsStart = m_payloadBytes + m_used;
+}
+
+void BinaryScenarioWriter::beginEvent(uint8_t tag, int timestamp) {
+    putByte(tag);
+    putSigned(static_cast<long long>(timestamp) - m_prevTimestamp);
+    m_prevTimestamp = timestamp;
+    m_eventCount++;
+}
+
+void BinaryScenarioWriter::putItems(const std::vector<std::pair<int, int>>& items) {
+    putVarint(items.size());
+    for (const auto& item : items) {
+        putSigned(item.first);
+        putSigned(item.second);
+    }
+}
+
+void BinaryScenarioWriter::writeOrder(int timestamp, int orderId, int destination, int dueBy, bool isVip,
+                                      const std::vector<std::pair<int, int>>& demand) {
+    beginEvent(BinaryScenario::TagOrder | (isVip ? BinaryScenario::TagVipFlag : 0), timestamp);
+    putSigned(static_cast<long long>(orderId) - m_prevOrderId);
+    m_prevOrderId = orderId;
+    putSigned(destination);
+    putSigned(static_cast<long long>(dueBy) - timestamp);
+    putItems(demand);
+}
+
+void BinaryScenarioWriter::writeRestock(int timestamp, int warehouseId,
+                                        const std::vector<std::pair<int, int>>& items) {
+    beginEvent(BinaryScenario::TagRestock, timestamp);
+    putSigned(warehouseId);
+    putItems(items);
+}
+
+void BinaryScenarioWriter::writeCancel(int timestamp, int orderId) {
+    beginEvent(BinaryScenario::TagCancel, timestamp);
+    putSigned(static_cast<long long>(orderId) - m_prevOrderId);
+    m_prevOrderId = orderId;
+}
+
+void BinaryScenarioWriter::writeMaintenance(int timestamp, int vehicleId, int duration) {
+    beginEvent(BinaryScenario::TagMaintenance, timestamp);
+    putSigned(vehicleId);
+    putSigned(duration);
+}
+
+void BinaryScenarioWriter::writeReroute(int timestamp, int nodeA, int nodeB, int newTime) {
+    beginEvent(BinaryScenario::TagReroute, timestamp);
+    putSigned(nodeA);
+    putSigned(nodeB);
+    putSigned(newTime);
+}
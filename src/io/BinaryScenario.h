@@ -0,0 +1,193 @@
+#ifndef BINARYSCENARIO_H
+#define BINARYSCENARIO_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "ScenarioWriter.h"
+
+// Binary scenario format, version 2. All integers are little-endian.
+//
+//   Header (64 bytes)
+//     0  char[8]  magic "WDSBIN\r\n"
+//     8  u32      version
+//    12  u32      header size (64)
+//    16  i32      warehouses W, items N, vehicles V
+//    28  u32      flags: bit 0 = coordinates section present (v2; 0 in v1)
+//    32  u64      event count
+//    40  u64      size of the event section in bytes
+//    48  u64      size of everything after the header in bytes
+//    56  u64      checksum of everything after the header (ScenarioChecksum)
+//
+//   Travel matrix   i32[W * W], row-major, rows/columns 1..W
+//   Vehicles        V x { i32 id, i32 type (0 standard, 1 refrigerated),
+//                         i32 speed, i32 capacity, i32 home warehouse }
+//   Warehouses      W x { i32 id, i32[N] inventory of items 1..N }
+//   Coordinates     if flagged: W x { f64 x, f64 y } for nodes 1..W (v2)
+//   Events          one tag byte (type R=0 S=1 C=2 M=3 U=4, +8 for VIP
+//                   orders) followed by zigzag varints:
+//                     all:  timestamp - previous event's timestamp
+//                     R:    order id - previous R/C order id, destination,
+//                           dueBy - timestamp, K, K x (item, quantity)
+//                     S:    warehouse, K, K x (item, quantity)
+//                     C:    order id - previous R/C order id
+//                     M:    vehicle, duration
+//                     U:    node a, node b, new time
+//
+// Fields are only ever appended in a new version; readers accept older
+// versions and reject those they do not know.
+
+namespace BinaryScenario {
+
+const char kMagic[8] = {'W', 'D', 'S', 'B', 'I', 'N', '\r', '\n'};
+const uint32_t kVersion = 2;
+const size_t kHeaderSize = 64;
+const uint32_t kFlagCoords = 1;
+
+enum Tag : uint8_t { TagOrder = 0, TagRestock = 1, TagCancel = 2, TagMaintenance = 3,
+                     TagReroute = 4, TagVipFlag = 8 };
+
+inline bool isBinary(const char* data, size_t size) {
+    return size >= sizeof(kMagic) && std::memcmp(data, kMagic, sizeof(kMagic)) == 0;
+}
+
+inline uint64_t zigzag(long long v) {
+    return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+inline long long unzigzag(uint64_t v) {
+    return static_cast<long long>(v >> 1) ^ -static_cast<long long>(v & 1);
+}
+
+// 64-bit multiply-xorshift hash over 8-byte little-endian words; a trailing
+// partial word is zero-padded. Fed incrementally, the result only depends on
+// the bytes, not on how they were split.
+class Checksum {
+public:
+    Checksum() : m_hash(0x9E3779B97F4A7C15ULL), m_pending(0), m_length(0) {}
+
+    void update(const char* data, size_t size);
+    uint64_t value() const;
+
+private:
+    static uint64_t mix(uint64_t h, uint64_t word) {
+        h = (h ^ word) * 0xBF58476D1CE4E5B9ULL;
+        return h ^ (h >> 31);
+    }
+
+    uint64_t m_hash;
+    unsigned char m_tail[8];
+    size_t m_pending;
+    uint64_t m_length;
+};
+
+// Bounds-checked little-endian reader over a mapped file
+class Cursor {
+public:
+    Cursor(const char* data, size_t size)
+        : m_pos(reinterpret_cast<const unsigned char*>(data)), m_end(m_pos + size) {}
+
+    size_t remaining() const { return static_cast<size_t>(m_end - m_pos); }
+    const char* position() const { return reinterpret_cast<const char*>(m_pos); }
+
+    // Caller checks remaining() first
+    int32_t i32() {
+        uint32_t v = uint32_t(m_pos[0]) | uint32_t(m_pos[1]) << 8 |
+                     uint32_t(m_pos[2]) << 16 | uint32_t(m_pos[3]) << 24;
+        m_pos += 4;
+        return static_cast<int32_t>(v);
+    }
+    uint64_t u64() {
+        uint64_t lo = static_cast<uint32_t>(i32());
+        uint64_t hi = static_cast<uint32_t>(i32());
+        return lo | hi << 32;
+    }
+    double f64() {
+        uint64_t bits = u64();
+        double v;
+        std::memcpy(&v, &bits, sizeof(v));
+        return v;
+    }
+
+    bool byte(uint8_t& v) {
+        if (m_pos >= m_end) return false;
+        v = *m_pos++;
+        return true;
+    }
+
+    bool varint(uint64_t& v) {
+        v = 0;
+        for (int shift = 0; shift < 64 && m_pos < m_end; shift += 7) {
+            uint8_t b = *m_pos++;
+            v |= uint64_t(b & 0x7F) << shift;
+            if (!(b & 0x80)) return true;
+        }
+        return false;
+    }
+
+    bool signedVarint(long long& v) {
+        uint64_t raw;
+        if (!varint(raw)) return false;
+        v = unzigzag(raw);
+        return true;
+    }
+
+private:
+    const unsigned char* m_pos;
+    const unsigned char* m_end;
+};
+
+} // namespace BinaryScenario
+
+// Writes the binary format above. The header is patched on close() once the
+// event count, section sizes and checksum are known, so the target must be a
+// seekable file.
+class BinaryScenarioWriter : public ScenarioWriter {
+public:
+    BinaryScenarioWriter();
+    ~BinaryScenarioWriter() override;
+
+    bool open(const std::string& filename) override;
+    bool close() override;
+
+    void writeHeader(int numWarehouses, int numItems, int numVehicles) override;
+    void writeTravelRow(const std::vector<int>& row) override;
+    void writeVehicle(int id, VehicleType type, int speed, int capacity, int homeWarehouse) override;
+    void writeWarehouse(int wid, const std::vector<int>& inventory) override;
+    void writeNodeCoords(const std::vector<std::pair<double, double>>& coords) override;
+    void beginEvents(long long count) override;
+
+    void writeOrder(int timestamp, int orderId, int destination, int dueBy, bool isVip,
+                    const std::vector<std::pair<int, int>>& demand) override;
+    void writeRestock(int timestamp, int warehouseId,
+                      const std::vector<std::pair<int, int>>& items) override;
+    void writeCancel(int timestamp, int orderId) override;
+    void writeMaintenance(int timestamp, int vehicleId, int duration) override;
+    void writeReroute(int timestamp, int nodeA, int nodeB, int newTime) override;
+
+private:
+    void putI32(int value);
+    void putF64(double value);
+    void putVarint(uint64_t value);
+    void putSigned(long long value) { putVarint(BinaryScenario::zigzag(value)); }
+    void putByte(uint8_t value);
+    void beginEvent(uint8_t tag, int timestamp);
+    void putItems(const std::vector<std::pair<int, int>>& items);
+    void flush();
+
+    std::FILE* m_file;
+    std::vector<char> m_buffer;
+    size_t m_used;
+    BinaryScenario::Checksum m_checksum;
+    uint64_t m_payloadBytes;
+    uint64_t m_eventsStart;
+    uint64_t m_eventCount;
+    int m_header[3];
+    uint32_t m_flags;
+    int m_prevTimestamp;
+    int m_prevOrderId;
+};
+
+#endif // BINARYSCENARIO_H
@@ -0,0 +1,439 @@
+#include "ColumnarWriter.h"
+#include <algorithm>
+#include <cstring>
+
+// Arrow IPC file layout:
+//
+//   "ARROW1\0\0"
+//   Schema message
+//   RecordBatch message + body, once per batch
+//   end-of-stream marker (0xFFFFFFFF, 0)
+//   Footer flatbuffer, i32 footer size, "ARROW1"
+//
+// Each message is 0xFFFFFFFF, i32 metadata size, a Message flatbuffer padded
+// to 8 bytes and the body. The flatbuffers are built by hand with the
+// minimum of the format needed for the tables below (Format/Schema.fbs,
+// Message.fbs and File.fbs in the Arrow sources).
+
+namespace {
+const char kArrowMagic[8] = {'A', 'R', 'R', 'O', 'W', '1', 0, 0};
+const int16_t kMetadataV5 = 4;
+const uint8_t kHeaderSchema = 1;
+const uint8_t kHeaderRecordBatch = 3;
+const uint8_t kTypeInt = 2;
+const uint8_t kTypeFloatingPoint = 3;
+const int16_t kPrecisionDouble = 2;
+const size_t kBufferAlignment = 64;
+
+size_t columnWidth(ArrowFileWriter::ColumnType type) {
+    return type == ArrowFileWriter::ColumnType::Int32 ? 4 : 8;
+}
+
+size_t alignUp(size_t n, size_t alignment) {
+    return (n + alignment - 1) / alignment * alignment;
+}
+
+// Flatbuffers are built back to front: objects are prepended, and an object
+// is referred to by its distance from the end of the buffer, which does not
+// change as more is prepended. Metadata is a few hundred bytes, so inserting
+// at the front of a vector is fine.
+class FlatBuilder {
+public:
+    size_t size() const { return m_data.size(); }
+
+    template<typename T>
+    size_t scalar(T value) {
+        align(sizeof(T), sizeof(T));
+        prependRaw(value);
+        return size();
+    }
+
+    size_t offset(size_t target) {
+        align(4, 4);
+        prependRaw(static_cast<uint32_t>(size() + 4 - target));
+        return size();
+    }
+
+    size_t string(const std::string& s) {
+        align(4, s.size() + 1);
+        m_data.insert(m_data.begin(), 0);
+        m_data.insert(m_data.begin(), s.begin(), s.end());
+        prependRaw(static_cast<uint32_t>(s.size()));
+        return size();
+    }
+
+    size_t offsetVector(const std::vector<size_t>& targets) {
+        align(4, 4 * targets.size());
+        for (auto it = targets.rbegin(); it != targets.rend(); ++it) offset(*it);
+        prependRaw(static_cast<uint32_t>(targets.size()));
+        return size();
+    }
+
+    // bytes holds count structs already laid out little-endian
+    size_t structVector(const std::vector<uint8_t>& bytes, size_t count) {
+        align(8, bytes.size());
+        m_data.insert(m_data.begin(), bytes.begin(), bytes.end());
+        prependRaw(static_cast<uint32_t>(count));
+        return size();
+    }
+
+    void startTable() {
+        m_tableStart = size();
+        m_fields.clear();
+    }
+
+    template<typename T>
+    void addScalar(int slot, T value) { m_fields.push_back({slot, scalar(value)}); }
+
+    void addOffset(int slot, size_t target) { m_fields.push_back({slot, offset(target)}); }
+
+    size_t endTable() {
+        size_t table = scalar<int32_t>(0);
+        int slots = 0;
+        for (const auto& f : m_fields) slots = std::max(slots, f.first + 1);
+
+        std::vector<uint16_t> vtable(2 + slots, 0);
+        vtable[0] = static_cast<uint16_t>(2 * vtable.size());
+        vtable[1] = static_cast<uint16_t>(table - m_tableStart);
+        for (const auto& f : m_fields) vtable[2 + f.first] = static_cast<uint16_t>(table - f.second);
+        for (auto it = vtable.rbegin(); it != vtable.rend(); ++it) prependRaw(*it);
+
+        // The table starts with the distance back to its vtable
+        int32_t toVtable = static_cast<int32_t>(size() - table);
+        store(m_data.data() + size() - table, static_cast<uint32_t>(toVtable));
+        return table;
+    }
+
+    std::vector<uint8_t> finish(size_t root) {
+        align(8, 4);
+        offset(root);
+        return m_data;
+    }
+
+    template<typename T>
+    static void store(uint8_t* p, T value) {
+        uint64_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(T));
+        for (size_t i = 0; i < sizeof(T); ++i) p[i] = static_cast<uint8_t>(bits >> (8 * i));
+    }
+
+private:
+    // Pads so that the buffer is aligned after 'additional' more bytes
+    void align(size_t alignment, size_t additional) {
+        size_t pad = (alignment - (size() + additional) % alignment) % alignment;
+        m_data.insert(m_data.begin(), pad, 0);
+    }
+
+    template<typename T>
+    void prependRaw(T value) {
+        uint8_t bytes[sizeof(T)];
+        store(bytes, value);
+        m_data.insert(m_data.begin(), bytes, bytes + sizeof(T));
+    }
+
+    std::vector<uint8_t> m_data;
+    size_t m_tableStart = 0;
+    std::vector<std::pair<int, size_t>> m_fields;
+};
+
+size_t buildSchema(FlatBuilder& fb, const std::vector<ArrowFileWriter::Column>& columns) {
+    std::vector<size_t> fields;
+    for (const auto& column : columns) {
+        size_t name = fb.string(column.name);
+
+        fb.startTable();
+        uint8_t typeTag;
+        if (column.type == ArrowFileWriter::ColumnType::Float64) {
+            fb.addScalar<int16_t>(0, kPrecisionDouble);
+            typeTag = kTypeFloatingPoint;
+        } else {
+            fb.addScalar<int32_t>(0, static_cast<int32_t>(8 * columnWidth(column.type)));
+            fb.addScalar<uint8_t>(1, 1);    // signed
+            typeTag = kTypeInt;
+        }
+        size_t type = fb.endTable();
+        size_t children = fb.offsetVector({});
+
+        fb.startTable();
+        fb.addOffset(0, name);
+        fb.addScalar<uint8_t>(1, 0);        // not nullable
+        fb.addScalar<uint8_t>(2, typeTag);
+        fb.addOffset(3, type);
+        fb.addOffset(5, children);
+        fields.push_back(fb.endTable());
+    }
+    size_t fieldVector = fb.offsetVector(fields);
+
+    fb.startTable();
+    fb.addScalar<int16_t>(0, 0);            // little-endian
+    fb.addOffset(1, fieldVector);
+    return fb.endTable();
+}
+
+std::vector<uint8_t> buildMessage(FlatBuilder& fb, uint8_t headerType, size_t header, int64_t bodyLength) {
+    fb.startTable();
+    fb.addScalar<int16_t>(0, kMetadataV5);
+    fb.addScalar<uint8_t>(1, headerType);
+    fb.addOffset(2, header);
+    fb.addScalar<int64_t>(3, bodyLength);
+    return fb.finish(fb.endTable());
+}
+}
+
+ArrowFileWriter::ArrowFileWriter() : m_file(nullptr), m_offset(0) {}
+
+ArrowFileWriter::~ArrowFileWriter() {
+    if (m_file) std::fclose(m_file);
+}
+
+bool ArrowFileWriter::open(const std::string& filename, const std::vector<Column>& schema) {
+    if (m_file) std::fclose(m_file);
+    m_file = std::fopen(filename.c_str(), "wb");
+    if (!m_file) {
+        m_error = "Could not open file for writing: " + filename;
+        return false;
+    }
+    m_offset = 0;
+    m_schema = schema;
+    m_batches.clear();
+
+    writeBytes(kArrowMagic, sizeof(kArrowMagic));
+    FlatBuilder fb;
+    size_t schemaTable = buildSchema(fb, m_schema);
+    writeMessage(buildMessage(fb, kHeaderSchema, schemaTable, 0));
+    return true;
+}
+
+bool ArrowFileWriter::writeBatch(size_t rows, const std::vector<const void*>& columns) {
+    if (!m_file) return false;
+
+    // Body: per column an empty validity bitmap and the values
+    std::vector<uint8_t> nodes;
+    std::vector<uint8_t> buffers;
+    int64_t bodyLength = 0;
+    auto addBuffer = [&](int64_t offset, int64_t length) {
+        uint8_t entry[16];
+        FlatBuilder::store(entry, offset);
+        FlatBuilder::store(entry + 8, length);
+        buffers.insert(buffers.end(), entry, entry + 16);
+    };
+    for (const auto& column : m_schema) {
+        uint8_t node[16];
+        FlatBuilder::store(node, static_cast<int64_t>(rows));
+        FlatBuilder::store(node + 8, int64_t(0));
+        nodes.insert(nodes.end(), node, node + 16);
+
+        addBuffer(bodyLength, 0);
+        size_t bytes = rows * columnWidth(column.type);
+        addBuffer(bodyLength, static_cast<int64_t>(bytes));
+        bodyLength += static_cast<int64_t>(alignUp(bytes, kBufferAlignment));
+    }
+
+    FlatBuilder fb;
+    size_t nodeVector = fb.structVector(nodes, m_schema.size());
+    size_t bufferVector = fb.structVector(buffers, 2 * m_schema.size());
+    fb.startTable();
+    fb.addScalar<int64_t>(0, static_cast<int64_t>(rows));
+    fb.addOffset(1, nodeVector);
+    fb.addOffset(2, bufferVector);
+    size_t batch = fb.endTable();
+
+    Block block;
+    block.offset = m_offset;
+    std::vector<uint8_t> metadata = buildMessage(fb, kHeaderRecordBatch, batch, bodyLength);
+    block.metadataLength = static_cast<int32_t>(8 + metadata.size());
+    block.bodyLength = bodyLength;
+    writeMessage(metadata);
+
+    for (size_t i = 0; i < m_schema.size(); ++i) {
+        // Values go out in host order, which the schema declares as little-endian
+        size_t bytes = rows * columnWidth(m_schema[i].type);
+        writeBytes(columns[i], bytes);
+        writePadding(alignUp(bytes, kBufferAlignment) - bytes);
+    }
+    m_batches.push_back(block);
+    return std::ferror(m_file) == 0;
+}
+
+bool ArrowFileWriter::close() {
+    if (!m_file) return true;
+
+    uint8_t endOfStream[8] = {0xFF, 0xFF, 0xFF, 0xFF, 0, 0, 0, 0};
+    writeBytes(endOfStream, sizeof(endOfStream));
+
+    std::vector<uint8_t> blocks;
+    for (const auto& b : m_batches) {
+        uint8_t entry[24] = {};
+        FlatBuilder::store(entry, b.offset);
+        FlatBuilder::store(entry + 8, b.metadataLength);
+        FlatBuilder::store(entry + 16, b.bodyLength);
+        blocks.insert(blocks.end(), entry, entry + 24);
+    }
+
+    FlatBuilder fb;
+    size_t schema = buildSchema(fb, m_schema);
+    size_t dictionaries = fb.structVector({}, 0);
+    size_t recordBatches = fb.structVector(blocks, m_batches.size());
+    fb.startTable();
+    fb.addScalar<int16_t>(0, kMetadataV5);
+    fb.addOffset(1, schema);
+    fb.addOffset(2, dictionaries);
+    fb.addOffset(3, recordBatches);
+    std::vector<uint8_t> footer = fb.finish(fb.endTable());
+
+    writeBytes(footer.data(), footer.size());
+    uint8_t footerSize[4];
+    FlatBuilder::store(footerSize, static_cast<int32_t>(footer.size()));
+    writeBytes(footerSize, sizeof(footerSize));
+    writeBytes(kArrowMagic, 6);
+
+    bool ok = std::ferror(m_file) == 0;
+    ok = (std::fclose(m_file) == 0) && ok;
+    m_file = nullptr;
+    if (!ok) m_error = "Write error while closing columnar file";
+    return ok;
+}
+
+void ArrowFileWriter::writeMessage(const std::vector<uint8_t>& metadata) {
+    // The flatbuffer size is a multiple of 8, so the body starts aligned
+    uint8_t prefix[8];
+    FlatBuilder::store(prefix, uint32_t(0xFFFFFFFF));
+    FlatBuilder::store(prefix + 4, static_cast<int32_t>(metadata.size()));
+    writeBytes(prefix, sizeof(prefix));
+    writeBytes(metadata.data(), metadata.size());
+}
+
+void ArrowFileWriter::writeBytes(const void* data, size_t size) {
+    if (size == 0) return;
+    std::fwrite(data, 1, size, m_file);
+    m_offset += static_cast<int64_t>(size);
+}
+
+void ArrowFileWriter::writePadding(size_t size) {
+    static const uint8_t zeros[kBufferAlignment] = {};
+    writeBytes(zeros, size);
+}
+
+namespace {
+const std::vector<ArrowFileWriter::Column> kDeliveryColumns = {
+    {"finish_time", ArrowFileWriter::ColumnType::Int32},
+    {"order_id", ArrowFileWriter::ColumnType::Int32},
+    {"request_time", ArrowFileWriter::ColumnType::Int32},
+    {"wait", ArrowFileWriter::ColumnType::Int32},
+    {"transit", ArrowFileWriter::ColumnType::Int32},
+    {"warehouse", ArrowFileWriter::ColumnType::Int32},
+    {"vehicle", ArrowFileWriter::ColumnType::Int32},
+    {"value", ArrowFileWriter::ColumnType::Float64},
+};
+
+// "results.arrow" -> "results.vehicles.arrow"
+std::string siblingPath(const std::string& filename, const std::string& table) {
+    const std::string ext = ".arrow";
+    std::string base = filename;
+    if (base.size() >= ext.size() && base.compare(base.size() - ext.size(), ext.size(), ext) == 0) {
+        base.erase(base.size() - ext.size());
+    }
+    return base + "." + table + ext;
+}
+}
+
+ColumnarResultsWriter::ColumnarResultsWriter() {}
+
+bool ColumnarResultsWriter::open(const std::string& filename) {
+    for (auto& column : m_columns) column.clear();
+    m_value.clear();
+    m_byVehicle.clear();
+    m_byWarehouse.clear();
+    m_vehiclesPath = siblingPath(filename, "vehicles");
+    m_warehousesPath = siblingPath(filename, "warehouses");
+
+    if (!m_deliveries.open(filename, kDeliveryColumns)) {
+        m_error = m_deliveries.getError();
+        return false;
+    }
+    return true;
+}
+
+void ColumnarResultsWriter::writeDelivery(const Order& o) {
+    int wait = o.getAssignTime() - o.getRequestTime();
+    int transit = o.getFinishTime() - o.getDispatchTime();
+    m_columns[0].push_back(o.getFinishTime());
+    m_columns[1].push_back(o.getId());
+    m_columns[2].push_back(o.getRequestTime());
+    m_columns[3].push_back(wait);
+    m_columns[4].push_back(transit);
+    m_columns[5].push_back(o.getAssignedWarehouse());
+    m_columns[6].push_back(o.getAssignedVehicle());
+    m_value.push_back(o.getValue());
+
+    bool onTime = o.getDueBy() == 0 || o.getFinishTime() <= o.getDueBy();
+    for (Aggregate* a : {&m_byVehicle[o.getAssignedVehicle()], &m_byWarehouse[o.getAssignedWarehouse()]}) {
+        a->deliveries++;
+        if (onTime) a->onTime++;
+        a->totalValue += o.getValue();
+        a->totalWait += wait;
+        a->totalTransit += transit;
+    }
+
+    if (m_value.size() >= kBatchRows) flushBatch();
+}
+
+bool ColumnarResultsWriter::flushBatch() {
+    if (m_value.empty()) return true;
+    std::vector<const void*> columns;
+    for (const auto& column : m_columns) columns.push_back(column.data());
+    columns.push_back(m_value.data());
+
+    bool ok = m_deliveries.writeBatch(m_value.size(), columns);
+    for (auto& column : m_columns) column.clear();
+    m_value.clear();
+    return ok;
+}
+
+bool ColumnarResultsWriter::finish() {
+    // An empty run still gets one (empty) batch so readers see the schema
+    bool ok = flushBatch();
+    if (ok && m_byVehicle.empty()) ok = m_deliveries.writeBatch(0, std::vector<const void*>(8, nullptr));
+    if (!m_deliveries.close() || !ok) {
+        m_error = m_deliveries.getError().empty() ? "Write error in columnar results" : m_deliveries.getError();
+        return false;
+    }
+    return writeAggregates(m_vehiclesPath, "vehicle", m_byVehicle) &&
+           writeAggregates(m_warehousesPath, "warehouse", m_byWarehouse);
+}
+
+bool ColumnarResultsWriter::writeAggregates(const std::string& filename, const char* idColumn,
+                                            const std::map<int, Aggregate>& groups) {
+    ArrowFileWriter writer;
+    std::vector<ArrowFileWriter::Column> schema = {
+        {idColumn, ArrowFileWriter::ColumnType::Int32},
+        {"deliveries", ArrowFileWriter::ColumnType::Int64},
+        {"on_time", ArrowFileWriter::ColumnType::Int64},
+        {"total_value", ArrowFileWriter::ColumnType::Float64},
+        {"avg_wait", ArrowFileWriter::ColumnType::Float64},
+        {"avg_transit", ArrowFileWriter::ColumnType::Float64},
+    };
+    if (!writer.open(filename, schema)) {
+        m_error = writer.getError();
+        return false;
+    }
+
+    std::vector<int32_t> ids;
+    std::vector<int64_t> deliveries, onTime;
+    std::vector<double> value, wait, transit;
+    for (const auto& [id, a] : groups) {
+        ids.push_back(id);
+        deliveries.push_back(a.deliveries);
+        onTime.push_back(a.onTime);
+        value.push_back(a.totalValue);
+        wait.push_back(a.totalWait / a.deliveries);
+        transit.push_back(a.totalTransit / a.deliveries);
+    }
+    bool ok = writer.writeBatch(ids.size(), {ids.data(), deliveries.data(), onTime.data(),
+                                             value.data(), wait.data(), transit.data()});
+    if (!writer.close() || !ok) {
+        m_error = writer.getError().empty() ? "Write error in " + filename : writer.getError();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,103 @@
+#ifndef COLUMNARWRITER_H
+#define COLUMNARWRITER_H
+
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+#include "models/Order.h"
+
+// Minimal writer for the Arrow IPC file format (Feather v2) restricted to
+// non-nullable fixed-width columns. Files open directly in pyarrow, pandas,
+// polars, DuckDB etc. and can be memory-mapped: every column of every record
+// batch is one contiguous, 64-byte aligned little-endian array.
+class ArrowFileWriter {
+public:
+    enum class ColumnType { Int32, Int64, Float64 };
+    struct Column {
+        std::string name;
+        ColumnType type;
+    };
+
+    ArrowFileWriter();
+    ~ArrowFileWriter();
+
+    ArrowFileWriter(const ArrowFileWriter&) = delete;
+    ArrowFileWriter& operator=(const ArrowFileWriter&) = delete;
+
+    bool open(const std::string& filename, const std::vector<Column>& schema);
+
+    // Appends a record batch; columns[i] points at rows values of schema[i]'s type
+    bool writeBatch(size_t rows, const std::vector<const void*>& columns);
+
+    // Writes the footer; the file is not readable before this
+    bool close();
+
+    std::string getError() const { return m_error; }
+
+private:
+    struct Block {
+        int64_t offset;
+        int32_t metadataLength;
+        int64_t bodyLength;
+    };
+
+    void writeMessage(const std::vector<uint8_t>& metadata);
+    void writeBytes(const void* data, size_t size);
+    void writePadding(size_t size);
+
+    std::FILE* m_file;
+    int64_t m_offset;
+    std::vector<Column> m_schema;
+    std::vector<Block> m_batches;
+    std::string m_error;
+};
+
+// Columnar counterpart of OutputWriter for analytics. The main file holds one
+// row per delivery (finish_time, order_id, request_time, wait, transit,
+// warehouse, vehicle, value); per-vehicle and per-warehouse aggregate tables
+// go next to it as <name>.vehicles.arrow and <name>.warehouses.arrow.
+// Deliveries are buffered in fixed-size record batches, so memory does not
+// grow with the number of rows.
+class ColumnarResultsWriter {
+public:
+    ColumnarResultsWriter();
+
+    bool open(const std::string& filename);
+    void writeDelivery(const Order& order);
+
+    // Flushes the last batch and writes the aggregate tables
+    bool finish();
+
+    std::string getVehiclesPath() const { return m_vehiclesPath; }
+    std::string getWarehousesPath() const { return m_warehousesPath; }
+    std::string getError() const { return m_error; }
+
+private:
+    struct Aggregate {
+        long long deliveries = 0;
+        long long onTime = 0;
+        double totalValue = 0;
+        double totalWait = 0;
+        double totalTransit = 0;
+    };
+
+    bool flushBatch();
+    bool writeAggregates(const std::string& filename, const char* idColumn,
+                         const std::map<int, Aggregate>& groups);
+
+    static constexpr size_t kBatchRows = 65536;
+
+    ArrowFileWriter m_deliveries;
+    std::vector<int32_t> m_columns[7];
+    std::vector<double> m_value;
+
+    std::map<int, Aggregate> m_byVehicle;
+    std::map<int, Aggregate> m_byWarehouse;
+    std::string m_vehiclesPath;
+    std::string m_warehousesPath;
+    std::string m_error;
+};
+
+#endif // COLUMNARWRITER_H
@@ -0,0 +1,90 @@
+#include "EventStream.h"
+#include <cstring>
+#include "InputParser.h"
+#include "TextScanner.h"
+
+EventStream::EventStream()
+    : m_begin(0), m_end(0), m_eof(false), m_line(0), m_remainingRecords(0),
+      m_windowSize(0), m_sequence(0), m_lastTimestamp(0), m_lateEvents(0) {}
+
+bool EventStream::open(const std::string& filename, long long offset, size_t firstLine,
+                       int numEvents, size_t reorderWindow) {
+    m_file.open(filename, std::ios::binary);
+    if (!m_file.is_open() || !m_file.seekg(offset)) {
+        m_error = "Could not open file: " + filename;
+        return false;
+    }
+    m_buffer.resize(kBufferSize);
+    m_begin = m_end = 0;
+    m_eof = false;
+    m_line = firstLine;
+    m_remainingRecords = numEvents;
+    m_windowSize = reorderWindow;
+    return true;
+}
+
+EventPtr EventStream::next() {
+    // Keep the window full so the earliest event within reach comes out first
+    while (m_window.size() <= m_windowSize && m_remainingRecords > 0 && m_error.empty()) {
+        EventPtr event;
+        if (!readRecord(event)) break;
+        if (event) m_window.push({event, m_sequence++});
+    }
+    if (m_window.empty()) return nullptr;
+
+    EventPtr event = m_window.top().event;
+    m_window.pop();
+    if (event->getTimestamp() < m_lastTimestamp) {
+        m_lateEvents++;
+    } else {
+        m_lastTimestamp = event->getTimestamp();
+    }
+    return event;
+}
+
+bool EventStream::readRecord(EventPtr& event) {
+    for (;;) {
+        const char* begin = m_buffer.data() + m_begin;
+        const char* end = m_buffer.data() + m_end;
+        if (!m_eof) {
+            // Only complete lines are scanned; a partial tail waits for the next read
+            while (end > begin && end[-1] != '\n') --end;
+        }
+
+        TextScanner in(begin, static_cast<size_t>(end - begin), m_line);
+        std::string error;
+        bool haveLine = in.nextLine(true);
+        if (haveLine && InputParser::parseEventRecord(in, event, m_lines, error)) {
+            m_begin = static_cast<size_t>(in.remaining() - m_buffer.data());
+            m_line = in.lineNumber();
+            m_remainingRecords--;
+            return true;
+        }
+
+        // A failure before the last buffered line is a real error; one at the
+        // end of the buffer may just be a record that continues in the file
+        if (m_eof || in.remaining() < end) {
+            m_error = haveLine ? error
+                    : "Line " + std::to_string(in.lineNumber() + 1) +
+                      ": unexpected end of file, expected event";
+            return false;
+        }
+        fill();
+    }
+}
+
+void EventStream::fill() {
+    size_t pending = m_end - m_begin;
+    if (m_begin > 0) {
+        std::memmove(m_buffer.data(), m_buffer.data() + m_begin, pending);
+        m_begin = 0;
+        m_end = pending;
+    }
+    // Only a single record longer than the buffer makes it grow
+    if (m_end == m_buffer.size()) m_buffer.resize(m_buffer.size() * 2);
+
+    m_file.read(m_buffer.data() + m_end, static_cast<std::streamsize>(m_buffer.size() - m_end));
+    size_t got = static_cast<size_t>(m_file.gcount());
+    m_end += got;
+    if (got == 0) m_eof = true;
+}
@@ -0,0 +1,52 @@
+#ifndef EVENTSTREAM_H
+#define EVENTSTREAM_H
+
+#include <fstream>
+#include <queue>
+#include <string>
+#include <vector>
+#include "models/Event.h"
+
+// Reads the event section of an input file incrementally through a fixed
+// read-ahead buffer, so memory does not grow with the length of the trace.
+// Events come out in timestamp order as long as no event is more than
+// reorderWindow records early; later stragglers are passed through as soon as
+// they are read and counted in getLateEvents().
+class EventStream : public EventSource {
+public:
+    EventStream();
+
+    // offset/firstLine locate the first record after the event count
+    bool open(const std::string& filename, long long offset, size_t firstLine,
+              int numEvents, size_t reorderWindow);
+
+    EventPtr next() override;
+    std::string getError() const override { return m_error; }
+
+    long long getLateEvents() const { return m_lateEvents; }
+
+private:
+    bool readRecord(EventPtr& event);
+    void fill();
+
+    static constexpr size_t kBufferSize = 1 << 20;
+
+    std::ifstream m_file;
+    std::vector<char> m_buffer;
+    size_t m_begin;
+    size_t m_end;
+    bool m_eof;
+    size_t m_line;
+    int m_remainingRecords;
+    std::vector<std::pair<int, int>> m_lines;
+
+    std::priority_queue<SequencedEvent, std::vector<SequencedEvent>, SequencedEventComparator> m_window;
+    size_t m_windowSize;
+    long long m_sequence;
+    int m_lastTimestamp;
+    long long m_lateEvents;
+
+    std::string m_error;
+};
+
+#endif // EVENTSTREAM_H
@@ -1,11 +1,32 @@
 #include "InputParser.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstring>
 #include <fstream>
 #include <sstream>
+#include <thread>
+#include "BinaryScenario.h"
+#include "EventStream.h"
+#include "MappedFile.h"
+#include "TextScanner.h"
+#include "core/Tracer.h"
 
 InputParser::InputParser() 
     : m_numWarehouses(0), m_numItems(0), m_numVehicles(0) {}
 
 bool InputParser::parse(const std::string& filename) {
+    MappedFile file;
+    if (file.open(filename)) {
+        if (BinaryScenario::isBinary(file.data(), file.size())) {
+            return parseBinary(file.data(), file.size());
+        }
+        return parseBuffer(file.data(), file.size());
+    }
+    return parseStream(filename);
+}
+
+bool InputParser::parseStream(const std::string& filename) {
     std::ifstream file(filename);
     if (!file.is_open()) {
         m_error = "Could not open file: " + filename;
@@ -96,6 +117,22 @@ bool InputParser::parseEvents(std::ifstream& file) {
     std::getline(file, line);
     while (line.empty()) std::getline(file, line);
     
+    // Optional COORDS block before it
+    if (line.compare(0, 6, "COORDS") == 0) {
+        m_nodeCoords.assign(m_numWarehouses + 1, {0.0, 0.0});
+        for (int i = 0; i < m_numWarehouses; ++i) {
+            std::getline(file, line);
+            while (line.empty()) std::getline(file, line);
+            
+            int node = 0;
+            double x = 0, y = 0;
+            std::stringstream(line) >> node >> x >> y;
+            if (node >= 1 && node <= m_numWarehouses) m_nodeCoords[node] = {x, y};
+        }
+        std::getline(file, line);
+        while (line.empty()) std::getline(file, line);
+    }
+    
     int numEvents;
     std::stringstream(line) >> numEvents;
     
@@ -166,3 +203,539 @@ bool InputParser::parseEvents(std::ifstream& file) {
     
     return true;
 }
+
+// ---- In-memory parser -------------------------------------------------------
+// Same grammar as the stream reader above: blank lines are skipped before the
+// header, each vehicle, each warehouse id, the event count and each event
+// record, but not inside the matrix, inventory or item lines.
+
+namespace {
+
+bool nextLine(TextScanner& in, bool skipBlank, const char* what, std::string& error) {
+    if (in.nextLine(skipBlank)) return true;
+    error = "Line " + std::to_string(in.lineNumber() + 1) +
+            ": unexpected end of file, expected " + what;
+    return false;
+}
+
+bool fieldError(const TextScanner& in, const char* what, std::string& error) {
+    error = "Line " + std::to_string(in.lineNumber()) + ", column " +
+            std::to_string(in.column()) + ": expected " + what;
+    return false;
+}
+
+bool readInt(TextScanner& in, int& value, const char* what, std::string& error) {
+    return in.readInt(value) || fieldError(in, what, error);
+}
+
+} // namespace
+
+bool InputParser::parseEventRecord(TextScanner& in, EventPtr& event,
+                                   std::vector<std::pair<int, int>>& lines, std::string& error) {
+    char eventType;
+    int timestamp;
+    event.reset();
+    if (!in.readChar(eventType)) return fieldError(in, "event type", error);
+    if (eventType != 'R' && eventType != 'S' && eventType != 'C' &&
+        eventType != 'M' && eventType != 'U') {
+        return true;
+    }
+    if (!readInt(in, timestamp, "event timestamp", error)) return false;
+    
+    if (eventType == 'R' || eventType == 'S') {
+        // R TS OrderID DestWID DueBy PriorityClass K / S TS WID K, then K item lines
+        int orderId = 0, destWid = 0, dueBy = 0, wid = 0, k;
+        std::string_view prioClass;
+        if (eventType == 'R') {
+            if (!readInt(in, orderId, "order id", error) ||
+                !readInt(in, destWid, "destination warehouse", error) ||
+                !readInt(in, dueBy, "due time", error)) {
+                return false;
+            }
+            if (!in.readWord(prioClass)) return fieldError(in, "priority class", error);
+        } else if (!readInt(in, wid, "warehouse id", error)) {
+            return false;
+        }
+        if (!readInt(in, k, "item line count", error)) return false;
+        
+        lines.clear();
+        for (int j = 0; j < k; ++j) {
+            int itemId, qty;
+            if (!nextLine(in, false, "item line", error) ||
+                !readInt(in, itemId, "item id", error) ||
+                !readInt(in, qty, "item quantity", error)) {
+                return false;
+            }
+            lines.push_back({itemId, qty});
+        }
+        
+        if (eventType == 'R') {
+            event = std::make_shared<OrderArrivalEvent>(
+                timestamp, orderId, destWid, dueBy, prioClass == "VIP", lines);
+        } else {
+            event = std::make_shared<RestockEvent>(timestamp, wid, lines);
+        }
+        
+    } else if (eventType == 'C') {
+        int orderId;
+        if (!readInt(in, orderId, "order id", error)) return false;
+        event = std::make_shared<CancelEvent>(timestamp, orderId);
+        
+    } else if (eventType == 'M') {
+        int vid, duration;
+        if (!readInt(in, vid, "vehicle id", error) ||
+            !readInt(in, duration, "maintenance duration", error)) {
+            return false;
+        }
+        event = std::make_shared<MaintenanceEvent>(timestamp, vid, duration);
+        
+    } else {
+        int nodeA, nodeB, newTime;
+        if (!readInt(in, nodeA, "node", error) || !readInt(in, nodeB, "node", error) ||
+            !readInt(in, newTime, "travel time", error)) {
+            return false;
+        }
+        event = std::make_shared<RerouteEvent>(timestamp, nodeA, nodeB, newTime);
+    }
+    return true;
+}
+
+namespace {
+
+// Slice of the event section parsed by one worker. Records whose header line
+// starts inside [begin, end) belong to the chunk; their item lines may run past end.
+struct EventChunk {
+    const char* begin;
+    const char* end;
+    std::vector<EventPtr> records;   // One entry per record, empty for unknown types
+    bool failed = false;
+};
+
+void parseChunk(EventChunk& chunk, const char* bufferEnd, size_t firstLine, std::string& error) {
+    TextScanner in(chunk.begin, static_cast<size_t>(bufferEnd - chunk.begin), firstLine);
+    std::vector<std::pair<int, int>> lines;
+    chunk.records.reserve(static_cast<size_t>(chunk.end - chunk.begin) / 16);
+    while (in.nextLine(true) && in.lineStart() < chunk.end) {
+        EventPtr event;
+        if (!InputParser::parseEventRecord(in, event, lines, error)) {
+            chunk.failed = true;
+            return;
+        }
+        chunk.records.push_back(std::move(event));
+    }
+}
+
+// Item lines are numeric, so a line whose first field starts with a letter is
+// always a record header and is a safe place to split
+const char* nextRecordStart(const char* p, const char* end) {
+    while (p < end) {
+        const char* nl = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+        if (!nl) return end;
+        p = nl + 1;
+        const char* q = p;
+        while (q < end && (*q == ' ' || *q == '\t' || *q == '\r')) ++q;
+        if (q < end && std::isalpha(static_cast<unsigned char>(*q))) return p;
+    }
+    return end;
+}
+
+} // namespace
+
+bool InputParser::parseBuffer(const char* data, size_t size) {
+    TextScanner in(data, size);
+    return parsePrelude(in) && parseEvents(in);
+}
+
+bool InputParser::parseStreaming(const std::string& filename, size_t reorderWindow) {
+    // Everything before the events is needed up front; mapping it only touches
+    // the pages that are actually read
+    MappedFile file;
+    if (!file.open(filename)) {
+        m_error = file.getError();
+        return false;
+    }
+    // Binary events are compact enough to load whole
+    if (BinaryScenario::isBinary(file.data(), file.size())) {
+        return parseBinary(file.data(), file.size());
+    }
+    
+    TextScanner in(file.data(), file.size());
+    int numEvents;
+    if (!parsePrelude(in) ||
+        !nextLine(in, true, "event count", m_error) ||
+        !readInt(in, numEvents, "event count", m_error)) {
+        return false;
+    }
+    
+    auto stream = std::make_shared<EventStream>();
+    long long offset = in.remaining() - file.data();
+    if (!stream->open(filename, offset, in.lineNumber(), numEvents, reorderWindow)) {
+        m_error = stream->getError();
+        return false;
+    }
+    m_eventStream = stream;
+    return true;
+}
+
+bool InputParser::parsePrelude(TextScanner& in) {
+    // First line: W N V
+    if (!nextLine(in, true, "header", m_error) ||
+        !readInt(in, m_numWarehouses, "warehouse count", m_error) ||
+        !readInt(in, m_numItems, "item count", m_error) ||
+        !readInt(in, m_numVehicles, "vehicle count", m_error)) {
+        return false;
+    }
+    
+    // Travel-time matrix (W x W)
+    m_travelTimes.assign(m_numWarehouses + 1, std::vector<int>(m_numWarehouses + 1, 0));
+    for (int i = 1; i <= m_numWarehouses; ++i) {
+        if (!nextLine(in, false, "travel-time row", m_error)) return false;
+        for (int j = 1; j <= m_numWarehouses; ++j) {
+            if (!readInt(in, m_travelTimes[i][j], "travel time", m_error)) return false;
+        }
+    }
+    
+    return parseVehicles(in) && parseWarehouses(in) && parseCoords(in);
+}
+
+bool InputParser::parseVehicles(TextScanner& in) {
+    for (int i = 0; i < m_numVehicles; ++i) {
+        int id, speed, capacity, refFlag, homeWid;
+        std::string_view type;
+        
+        if (!nextLine(in, true, "vehicle", m_error) ||
+            !readInt(in, id, "vehicle id", m_error)) {
+            return false;
+        }
+        if (!in.readWord(type)) return fieldError(in, "vehicle type", m_error);
+        if (!readInt(in, speed, "vehicle speed", m_error) ||
+            !readInt(in, capacity, "vehicle capacity", m_error) ||
+            !readInt(in, refFlag, "refrigerated flag", m_error) ||
+            !readInt(in, homeWid, "home warehouse", m_error)) {
+            return false;
+        }
+        
+        VehicleType vtype = (type == "Refrigerated" || refFlag == 1) 
+                           ? VehicleType::Refrigerated : VehicleType::Standard;
+        
+        m_vehicles[id] = Vehicle(id, vtype, speed, capacity, homeWid);
+    }
+    
+    return true;
+}
+
+bool InputParser::parseWarehouses(TextScanner& in) {
+    for (int i = 0; i < m_numWarehouses; ++i) {
+        int wid;
+        if (!nextLine(in, true, "warehouse id", m_error) ||
+            !readInt(in, wid, "warehouse id", m_error)) {
+            return false;
+        }
+        
+        Warehouse& warehouse = m_warehouses[wid];
+        warehouse = Warehouse(wid, wid);  // Location node = warehouse ID
+        
+        if (!nextLine(in, false, "inventory line", m_error)) return false;
+        for (int j = 1; j <= m_numItems; ++j) {
+            int qty;
+            if (!readInt(in, qty, "inventory quantity", m_error)) return false;
+            warehouse.setInventory(j, qty);
+        }
+    }
+    
+    return true;
+}
+
+bool InputParser::parseCoords(TextScanner& in) {
+    // Optional block: "COORDS", then "node x y" for every node
+    TextScanner probe = in;
+    std::string_view word;
+    if (!probe.nextLine(true) || !probe.readWord(word) || word != "COORDS") return true;
+    in = probe;
+    
+    m_nodeCoords.assign(m_numWarehouses + 1, {0.0, 0.0});
+    for (int i = 0; i < m_numWarehouses; ++i) {
+        int node;
+        if (!nextLine(in, true, "node coordinates", m_error) ||
+            !readInt(in, node, "node id", m_error)) {
+            return false;
+        }
+        if (node < 1 || node > m_numWarehouses) return fieldError(in, "node id within the travel matrix", m_error);
+        if (!in.readDouble(m_nodeCoords[node].first)) return fieldError(in, "x coordinate", m_error);
+        if (!in.readDouble(m_nodeCoords[node].second)) return fieldError(in, "y coordinate", m_error);
+    }
+    
+    return true;
+}
+
+bool InputParser::parseEvents(TextScanner& in) {
+    int numEvents;
+    if (!nextLine(in, true, "event count", m_error) ||
+        !readInt(in, numEvents, "event count", m_error)) {
+        return false;
+    }
+    
+    const char* region = in.remaining();
+    const char* end = in.end();
+    size_t regionSize = static_cast<size_t>(end - region);
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    if (threads > 1 && regionSize >= kParallelEventBytes && numEvents > 0) {
+        return parseEventsParallel(region, end, in.lineNumber(), numEvents, threads);
+    }
+    
+    // A corrupt count must not turn into a huge allocation
+    m_events.reserve(std::min<size_t>(std::max(numEvents, 0), 1 << 20));
+    
+    std::vector<std::pair<int, int>> lines;
+    for (int i = 0; i < numEvents; ++i) {
+        EventPtr event;
+        if (!nextLine(in, true, "event", m_error) ||
+            !parseEventRecord(in, event, lines, m_error)) {
+            return false;
+        }
+        if (event) m_events.push_back(std::move(event));
+    }
+    
+    return true;
+}
+
+bool InputParser::parseEventsParallel(const char* begin, const char* end, size_t firstLine,
+                                      int numEvents, unsigned threads) {
+    // Several chunks per thread so an uneven mix of record sizes still balances
+    size_t regionSize = static_cast<size_t>(end - begin);
+    size_t target = std::max<size_t>(regionSize / (threads * 4), kParallelEventBytes / 4);
+    
+    std::vector<EventChunk> chunks;
+    const char* chunkBegin = begin;
+    while (chunkBegin < end) {
+        const char* split = regionSize - static_cast<size_t>(chunkBegin - begin) > target
+                          ? nextRecordStart(chunkBegin + target, end) : end;
+        chunks.push_back({chunkBegin, split, {}});
+        chunkBegin = split;
+    }
+    
+    std::vector<std::string> errors(chunks.size());
+    std::atomic<size_t> nextChunk(0);
+    auto worker = [&]() {
+        for (size_t c; (c = nextChunk.fetch_add(1)) < chunks.size();) {
+            Tracer::Span span("parse chunk");
+            span.setArg("bytes", chunks[c].end - chunks[c].begin);
+            parseChunk(chunks[c], end, 0, errors[c]);
+        }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < std::min<size_t>(threads, chunks.size()); ++t) {
+        pool.emplace_back([&]() {
+            Tracer::setThreadName("parser worker");
+            worker();
+        });
+    }
+    worker();
+    for (std::thread& t : pool) t.join();
+    
+    // Only the first numEvents records count; anything after them is ignored
+    // exactly as the serial reader would, including errors
+    size_t wanted = static_cast<size_t>(numEvents);
+    size_t records = 0;
+    size_t used = 0;
+    for (; used < chunks.size() && records < wanted; ++used) {
+        const EventChunk& chunk = chunks[used];
+        records += chunk.records.size();
+        if (chunk.failed && records < wanted) {
+            // Re-run the chunk with absolute line numbers for the message
+            size_t base = firstLine + static_cast<size_t>(std::count(begin, chunk.begin, '\n'));
+            EventChunk retry{chunk.begin, chunk.end, {}};
+            parseChunk(retry, end, base, m_error);
+            return false;
+        }
+    }
+    if (records < wanted) {
+        size_t lastLine = firstLine + static_cast<size_t>(std::count(begin, end, '\n'));
+        if (end > begin && end[-1] != '\n') ++lastLine;
+        m_error = "Line " + std::to_string(lastLine + 1) + ": unexpected end of file, expected event";
+        return false;
+    }
+    
+    size_t total = 0;
+    for (size_t c = 0, seen = 0; c < used; ++c) {
+        for (const EventPtr& e : chunks[c].records) {
+            if (seen++ >= wanted) break;
+            if (e) ++total;
+        }
+    }
+    m_events.reserve(m_events.size() + total);
+    for (size_t c = 0, seen = 0; c < used; ++c) {
+        for (EventPtr& e : chunks[c].records) {
+            if (seen++ >= wanted) break;
+            if (e) m_events.push_back(std::move(e));
+        }
+    }
+    return true;
+}
+
+// ---- Binary format ----------------------------------------------------------
+// Layout is documented in BinaryScenario.h. Fixed-size sections are copied
+// straight out of the mapping; only the event section needs decoding.
+
+bool InputParser::parseBinary(const char* data, size_t size) {
+    if (size < BinaryScenario::kHeaderSize) {
+        m_error = "Binary scenario is truncated";
+        return false;
+    }
+    
+    BinaryScenario::Cursor header(data + sizeof(BinaryScenario::kMagic),
+                                  BinaryScenario::kHeaderSize - sizeof(BinaryScenario::kMagic));
+    uint32_t version = static_cast<uint32_t>(header.i32());
+    uint32_t headerSize = static_cast<uint32_t>(header.i32());
+    int numWarehouses = header.i32();
+    int numItems = header.i32();
+    int numVehicles = header.i32();
+    uint32_t flags = static_cast<uint32_t>(header.i32());
+    uint64_t eventCount = header.u64();
+    uint64_t eventBytes = header.u64();
+    uint64_t payloadBytes = header.u64();
+    uint64_t checksum = header.u64();
+    
+    if (version < 1 || version > BinaryScenario::kVersion || headerSize != BinaryScenario::kHeaderSize ||
+        (flags & ~BinaryScenario::kFlagCoords) != 0 || (version == 1 && flags != 0)) {
+        m_error = "Unsupported binary scenario version " + std::to_string(version);
+        return false;
+    }
+    if (payloadBytes != size - BinaryScenario::kHeaderSize) {
+        m_error = "Binary scenario is truncated or has trailing data";
+        return false;
+    }
+    
+    const char* payload = data + BinaryScenario::kHeaderSize;
+    BinaryScenario::Checksum actual;
+    actual.update(payload, static_cast<size_t>(payloadBytes));
+    if (actual.value() != checksum) {
+        m_error = "Binary scenario checksum mismatch";
+        return false;
+    }
+    
+    uint64_t w = static_cast<uint64_t>(numWarehouses);
+    bool hasCoords = (flags & BinaryScenario::kFlagCoords) != 0;
+    uint64_t fixedBytes = 4 * w * w + 20 * static_cast<uint64_t>(numVehicles) +
+                          w * (4 + 4 * static_cast<uint64_t>(numItems)) + (hasCoords ? 16 * w : 0);
+    if (numWarehouses < 0 || numItems < 0 || numVehicles < 0 ||
+        numWarehouses > 1000000 || fixedBytes + eventBytes != payloadBytes) {
+        m_error = "Binary scenario section sizes do not match its header";
+        return false;
+    }
+    
+    m_numWarehouses = numWarehouses;
+    m_numItems = numItems;
+    m_numVehicles = numVehicles;
+    BinaryScenario::Cursor in(payload, static_cast<size_t>(payloadBytes));
+    
+    m_travelTimes.assign(m_numWarehouses + 1, std::vector<int>(m_numWarehouses + 1, 0));
+    for (int i = 1; i <= m_numWarehouses; ++i) {
+        for (int j = 1; j <= m_numWarehouses; ++j) {
+            m_travelTimes[i][j] = in.i32();
+        }
+    }
+    
+    for (int i = 0; i < m_numVehicles; ++i) {
+        int id = in.i32();
+        VehicleType type = in.i32() == 1 ? VehicleType::Refrigerated : VehicleType::Standard;
+        int speed = in.i32();
+        int capacity = in.i32();
+        int homeWid = in.i32();
+        m_vehicles[id] = Vehicle(id, type, speed, capacity, homeWid);
+    }
+    
+    for (int i = 0; i < m_numWarehouses; ++i) {
+        int wid = in.i32();
+        Warehouse& warehouse = m_warehouses[wid];
+        warehouse = Warehouse(wid, wid);
+        for (int j = 1; j <= m_numItems; ++j) {
+            warehouse.setInventory(j, in.i32());
+        }
+    }
+    
+    if (hasCoords) {
+        m_nodeCoords.assign(m_numWarehouses + 1, {0.0, 0.0});
+        for (int node = 1; node <= m_numWarehouses; ++node) {
+            double x = in.f64();
+            m_nodeCoords[node] = {x, in.f64()};
+        }
+    }
+    
+    // Every event takes at least two bytes, which bounds a corrupt count
+    m_events.reserve(static_cast<size_t>(std::min(eventCount, eventBytes / 2)));
+    
+    long long timestamp = 0;
+    long long orderId = 0;
+    std::vector<std::pair<int, int>> lines;
+    auto readItems = [&]() {
+        uint64_t k;
+        if (!in.varint(k) || k > in.remaining()) return false;
+        lines.clear();
+        for (uint64_t j = 0; j < k; ++j) {
+            long long item, qty;
+            if (!in.signedVarint(item) || !in.signedVarint(qty)) return false;
+            lines.push_back({static_cast<int>(item), static_cast<int>(qty)});
+        }
+        return true;
+    };
+    
+    for (uint64_t e = 0; e < eventCount; ++e) {
+        uint8_t tag;
+        long long delta, a, b, c;
+        bool ok = in.byte(tag) && in.signedVarint(delta);
+        timestamp += delta;
+        int ts = static_cast<int>(timestamp);
+        
+        switch (ok ? (tag & ~BinaryScenario::TagVipFlag) : -1) {
+            case BinaryScenario::TagOrder:
+                ok = in.signedVarint(a) && in.signedVarint(b) && in.signedVarint(c) && readItems();
+                if (ok) {
+                    orderId += a;
+                    m_events.push_back(std::make_shared<OrderArrivalEvent>(
+                        ts, static_cast<int>(orderId), static_cast<int>(b), static_cast<int>(timestamp + c),
+                        (tag & BinaryScenario::TagVipFlag) != 0, lines));
+                }
+                break;
+            case BinaryScenario::TagRestock:
+                ok = in.signedVarint(a) && readItems();
+                if (ok) m_events.push_back(std::make_shared<RestockEvent>(ts, static_cast<int>(a), lines));
+                break;
+            case BinaryScenario::TagCancel:
+                ok = in.signedVarint(a);
+                if (ok) {
+                    orderId += a;
+                    m_events.push_back(std::make_shared<CancelEvent>(ts, static_cast<int>(orderId)));
+                }
+                break;
+            case BinaryScenario::TagMaintenance:
+                ok = in.signedVarint(a) && in.signedVarint(b);
+                if (ok) {
+                    m_events.push_back(std::make_shared<MaintenanceEvent>(
+                        ts, static_cast<int>(a), static_cast<int>(b)));
+                }
+                break;
+            case BinaryScenario::TagReroute:
+                ok = in.signedVarint(a) && in.signedVarint(b) && in.signedVarint(c);
+                if (ok) {
+                    m_events.push_back(std::make_shared<RerouteEvent>(
+                        ts, static_cast<int>(a), static_cast<int>(b), static_cast<int>(c)));
+                }
+                break;
+            default:
+                ok = false;
+                break;
+        }
+        
+        if (!ok) {
+            m_error = "Binary scenario: corrupt event #" + std::to_string(e + 1);
+            return false;
+        }
+    }
+    
+    if (in.remaining() != 0) {
+        m_error = "Binary scenario: trailing bytes after the last event";
+        return false;
+    }
+    return true;
+}
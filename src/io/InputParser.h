@@ -9,37 +9,76 @@
 #include "models/Vehicle.h"
 #include "models/Event.h"
 
+class EventStream;
+class TextScanner;
+
 class InputParser {
 public:
     InputParser();
     
+    // Memory-maps the file and parses it in place; inputs that cannot be
+    // mapped (pipes, devices) go through the stream reader instead. Binary
+    // scenarios (see BinaryScenario.h) are recognised by their magic bytes.
     bool parse(const std::string& filename);
     
+    // Parses an in-memory copy of an input file. Errors carry line and column.
+    bool parseBuffer(const char* data, size_t size);
+    
+    // Parses everything up to the event records; the events themselves are
+    // left in the file and read on demand through getEventStream(). Out-of-order
+    // timestamps are sorted within a window of reorderWindow events. Binary
+    // scenarios are loaded whole.
+    bool parseStreaming(const std::string& filename, size_t reorderWindow = 0);
+    
+    // Parses one event record starting on the scanner's current line (item
+    // lines included). Unknown record types leave event empty.
+    static bool parseEventRecord(TextScanner& in, EventPtr& event,
+                                 std::vector<std::pair<int, int>>& lines, std::string& error);
+    
     // Getters for parsed data
     int getNumWarehouses() const { return m_numWarehouses; }
     int getNumItems() const { return m_numItems; }
     int getNumVehicles() const { return m_numVehicles; }
     
     const std::vector<std::vector<int>>& getTravelTimes() const { return m_travelTimes; }
+    // Per-node (x, y) from the optional COORDS block, indexed like the travel
+    // matrix; empty when the scenario has none
+    const std::vector<std::pair<double, double>>& getNodeCoords() const { return m_nodeCoords; }
     const std::map<int, Warehouse>& getWarehouses() const { return m_warehouses; }
     const std::map<int, Vehicle>& getVehicles() const { return m_vehicles; }
     const std::vector<EventPtr>& getEvents() const { return m_events; }
+    std::shared_ptr<EventStream> getEventStream() const { return m_eventStream; }
     
     std::string getError() const { return m_error; }
     
 private:
+    bool parseStream(const std::string& filename);
+    bool parseBinary(const char* data, size_t size);
     bool parseVehicles(std::ifstream& file);
     bool parseWarehouses(std::ifstream& file);
     bool parseEvents(std::ifstream& file);
     
+    bool parsePrelude(TextScanner& in);
+    bool parseVehicles(TextScanner& in);
+    bool parseWarehouses(TextScanner& in);
+    bool parseCoords(TextScanner& in);
+    bool parseEvents(TextScanner& in);
+    bool parseEventsParallel(const char* begin, const char* end, size_t firstLine,
+                             int numEvents, unsigned threads);
+    
+    // Event sections smaller than this are parsed on the calling thread
+    static constexpr size_t kParallelEventBytes = 4 << 20;
+    
     int m_numWarehouses;
     int m_numItems;
     int m_numVehicles;
     
     std::vector<std::vector<int>> m_travelTimes;
+    std::vector<std::pair<double, double>> m_nodeCoords;
     std::map<int, Warehouse> m_warehouses;
     std::map<int, Vehicle> m_vehicles;
     std::vector<EventPtr> m_events;
+    std::shared_ptr<EventStream> m_eventStream;
     
     std::string m_error;
 };
@@ -0,0 +1,37 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+// Read-only memory mapping of a whole file. The mapping lives as long as the
+// object; an empty file maps successfully with data() == nullptr.
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& filename);
+    void close();
+
+    const char* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    bool isOpen() const { return m_open; }
+
+    std::string getError() const { return m_error; }
+
+private:
+    const char* m_data;
+    size_t m_size;
+    bool m_open;
+#ifdef _WIN32
+    void* m_file;
+    void* m_mapping;
+#endif
+    std::string m_error;
+};
+
+#endif // MAPPEDFILE_H
@@ -1,6 +1,10 @@
 #include "OutputWriter.h"
-#include <fstream>
-#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+namespace {
+const size_t kWriteBufferSize = 1 << 20;
+}
 
 OutputWriter::OutputWriter() {}
 
@@ -8,49 +12,125 @@ bool OutputWriter::writeImpl(const std::string& filename,
                              const std::map<int, Order>& orders,
                              const std::vector<int>& deliveredOrders,
                              const Statistics& stats) {
-    std::ofstream out(filename);
-    if (!out.is_open()) {
-        m_error = "Could not open file for writing: " + filename;
+    StreamingOutputWriter out;
+    if (!out.open(filename)) {
+        m_error = out.getError();
         return false;
     }
     
-    // Sort delivered orders by finish time
-    std::vector<int> sorted = deliveredOrders;
-    std::sort(sorted.begin(), sorted.end(), [&orders](int a, int b) {
-        return orders.at(a).getFinishTime() < orders.at(b).getFinishTime();
-    });
+    // Deliveries are recorded as they happen, so they are already ordered by finish time
+    for (int oid : deliveredOrders) {
+        out.writeDelivery(orders.at(oid));
+    }
     
-    // Write each delivered order
-    // Format: FT OrderID RT WT TransitTime AssignedWID AssignedVID Filled Value
-    for (int oid : sorted) {
-        const Order& o = orders.at(oid);
-        int waitTime = o.getAssignTime() - o.getRequestTime();
-        int transitTime = o.getFinishTime() - o.getDispatchTime();
-        
-        out << o.getFinishTime() << " "
-            << o.getId() << " "
-            << o.getRequestTime() << " "
-            << waitTime << " "
-            << transitTime << " "
-            << o.getAssignedWarehouse() << " "
-            << o.getAssignedVehicle() << " "
-            << "Yes " 
-            << o.getValue() << "\n";
+    if (!out.finish(stats)) {
+        m_error = out.getError();
+        return false;
+    }
+    return true;
+}
+
+StreamingOutputWriter::StreamingOutputWriter()
+    : m_file(nullptr), m_buffer(kWriteBufferSize), m_used(0) {}
+
+StreamingOutputWriter::~StreamingOutputWriter() {
+    if (m_file) {
+        flush();
+        std::fclose(m_file);
     }
+}
+
+bool StreamingOutputWriter::open(const std::string& filename) {
+    m_file = std::fopen(filename.c_str(), "w");
+    if (!m_file) {
+        m_error = "Could not open file for writing: " + filename;
+        return false;
+    }
+    m_used = 0;
+    return true;
+}
+
+void StreamingOutputWriter::writeDelivery(const Order& o) {
+    // Format: FT OrderID RT WT TransitTime AssignedWID AssignedVID Filled Value
+    putInt(o.getFinishTime()); putChar(' ');
+    putInt(o.getId()); putChar(' ');
+    putInt(o.getRequestTime()); putChar(' ');
+    putInt(o.getAssignTime() - o.getRequestTime()); putChar(' ');
+    putInt(o.getFinishTime() - o.getDispatchTime()); putChar(' ');
+    putInt(o.getAssignedWarehouse()); putChar(' ');
+    putInt(o.getAssignedVehicle()); putChar(' ');
+    putText("Yes ");
+    putDouble(o.getValue()); putChar('\n');
+}
+
+bool StreamingOutputWriter::finishImpl(const OutputWriter::Statistics& stats) {
+    if (!m_file) return false;
     
-    out << "\n";
+    putChar('\n');
+    putText("Total Orders: "); putInt(stats.totalOrders); putChar('\n');
+    putText("VIP Orders: "); putInt(stats.vipOrders); putChar('\n');
+    putText("Standard Orders: "); putInt(stats.stdOrders); putChar('\n');
+    putText("Delivered: "); putInt(stats.deliveredOrders); putChar('\n');
+    putText("Canceled: "); putInt(stats.canceledOrders); putChar('\n');
+    putText("Total Value: "); putDouble(stats.totalValue); putChar('\n');
+    putText("Avg Wait Time: "); putDouble(stats.avgWaitTime); putChar('\n');
+    putText("Avg Transit Time: "); putDouble(stats.avgTransitTime); putChar('\n');
+    putText("On-Time Rate: "); putDouble(stats.onTimeRate); putText("%\n");
     
-    // Write statistics
-    out << "Total Orders: " << stats.totalOrders << "\n";
-    out << "VIP Orders: " << stats.vipOrders << "\n";
-    out << "Standard Orders: " << stats.stdOrders << "\n";
-    out << "Delivered: " << stats.deliveredOrders << "\n";
-    out << "Canceled: " << stats.canceledOrders << "\n";
-    out << "Total Value: " << stats.totalValue << "\n";
-    out << "Avg Wait Time: " << stats.avgWaitTime << "\n";
-    out << "Avg Transit Time: " << stats.avgTransitTime << "\n";
-    out << "On-Time Rate: " << stats.onTimeRate << "%\n";
+    // Format: <metric> <class>: p50 p90 p99 p99.9 (delivered orders)
+    putChar('\n');
+    putText("Latency Percentiles (p50 p90 p99 p99.9):\n");
+    for (int m = 0; m < LatencyStats::MetricCount; ++m) {
+        for (int c = 0; c < LatencyStats::ClassCount; ++c) {
+            const LatencyPercentiles& p = stats.latency.values[m][c];
+            putText(LatencyStats::metricName(m)); putChar(' ');
+            putText(LatencyStats::className(c)); putText(": ");
+            putInt(p.p50); putChar(' ');
+            putInt(p.p90); putChar(' ');
+            putInt(p.p99); putChar(' ');
+            putInt(p.p999); putChar('\n');
+        }
+    }
     
-    out.close();
-    return true;
+    flush();
+    bool ok = std::ferror(m_file) == 0;
+    ok = (std::fclose(m_file) == 0) && ok;
+    m_file = nullptr;
+    if (!ok) m_error = "Write error while saving results";
+    return ok;
+}
+
+void StreamingOutputWriter::flush() {
+    if (m_file && m_used > 0) {
+        std::fwrite(m_buffer.data(), 1, m_used, m_file);
+    }
+    m_used = 0;
+}
+
+void StreamingOutputWriter::putInt(long long value) {
+    if (m_used + 24 > m_buffer.size()) flush();
+    char* begin = m_buffer.data() + m_used;
+    auto res = std::to_chars(begin, m_buffer.data() + m_buffer.size(), value);
+    m_used += res.ptr - begin;
+}
+
+void StreamingOutputWriter::putDouble(double value) {
+    // Same text as ostream's default formatting (%g, 6 significant digits)
+    if (m_used + 32 > m_buffer.size()) flush();
+    char* begin = m_buffer.data() + m_used;
+    auto res = std::to_chars(begin, m_buffer.data() + m_buffer.size(), value,
+                             std::chars_format::general, 6);
+    m_used += res.ptr - begin;
+}
+
+void StreamingOutputWriter::putText(const char* text) {
+    size_t len = std::strlen(text);
+    if (m_used + len > m_buffer.size()) flush();
+    std::memcpy(m_buffer.data() + m_used, text, len);
+    m_used += len;
+}
+
+void StreamingOutputWriter::putChar(char c) {
+    if (m_used + 1 > m_buffer.size()) flush();
+    m_buffer[m_used++] = c;
 }
@@ -1,9 +1,11 @@
 #ifndef OUTPUTWRITER_H
 #define OUTPUTWRITER_H
 
+#include <cstdio>
 #include <string>
 #include <vector>
 #include <map>
+#include "core/LatencyHistogram.h"
 #include "models/Order.h"
 
 class OutputWriter {
@@ -21,14 +23,11 @@ public:
         double avgWaitTime = 0;
         double avgTransitTime = 0;
         double onTimeRate = 0;
+        LatencyStats::Summary latency;
     };
     
-    // Template method to accept any statistics-like struct
     template<typename T>
-    bool write(const std::string& filename,
-               const std::map<int, Order>& orders,
-               const std::vector<int>& deliveredOrders,
-               const T& stats) {
+    static Statistics toStatistics(const T& stats) {
         Statistics s;
         s.totalOrders = stats.totalOrders;
         s.deliveredOrders = stats.deliveredOrders;
@@ -39,7 +38,18 @@ public:
         s.avgWaitTime = stats.avgWaitTime;
         s.avgTransitTime = stats.avgTransitTime;
         s.onTimeRate = stats.onTimeRate;
-        return writeImpl(filename, orders, deliveredOrders, s);
+        s.latency = stats.latency;
+        return s;
+    }
+    
+    // Template method to accept any statistics-like struct. deliveredOrders
+    // must be in delivery order (non-decreasing finish time).
+    template<typename T>
+    bool write(const std::string& filename,
+               const std::map<int, Order>& orders,
+               const std::vector<int>& deliveredOrders,
+               const T& stats) {
+        return writeImpl(filename, orders, deliveredOrders, toStatistics(stats));
     }
     
     std::string getError() const { return m_error; }
@@ -52,4 +62,40 @@ private:
     std::string m_error;
 };
 
+// Writes the same file as OutputWriter incrementally: one line per delivery as
+// it happens, then the statistics block from finish(). Lines are formatted
+// into a large buffer and written out in big blocks.
+class StreamingOutputWriter {
+public:
+    StreamingOutputWriter();
+    ~StreamingOutputWriter();
+    
+    StreamingOutputWriter(const StreamingOutputWriter&) = delete;
+    StreamingOutputWriter& operator=(const StreamingOutputWriter&) = delete;
+    
+    bool open(const std::string& filename);
+    bool isOpen() const { return m_file != nullptr; }
+    
+    void writeDelivery(const Order& order);
+    
+    // Appends the statistics block and closes the file
+    template<typename T>
+    bool finish(const T& stats) { return finishImpl(OutputWriter::toStatistics(stats)); }
+    
+    std::string getError() const { return m_error; }
+    
+private:
+    bool finishImpl(const OutputWriter::Statistics& stats);
+    void putInt(long long value);
+    void putDouble(double value);
+    void putText(const char* text);
+    void putChar(char c);
+    void flush();
+    
+    std::FILE* m_file;
+    std::vector<char> m_buffer;
+    size_t m_used;
+    std::string m_error;
+};
+
 #endif // OUTPUTWRITER_H
@@ -0,0 +1,186 @@
+#include "ScenarioWriter.h"
+#include <charconv>
+#include <cstring>
+
+namespace {
+const size_t kWriteBufferSize = 1 << 20;
+}
+
+void ScenarioWriter::writeEvent(const Event& event) {
+    int ts = event.getTimestamp();
+    switch (event.getType()) {
+        case EventType::OrderArrival: {
+            const auto& e = static_cast<const OrderArrivalEvent&>(event);
+            writeOrder(ts, e.getOrderId(), e.getDestination(), e.getDueBy(), e.isVip(), e.getDemand());
+            break;
+        }
+        case EventType::Restock: {
+            const auto& e = static_cast<const RestockEvent&>(event);
+            writeRestock(ts, e.getWarehouseId(), e.getItems());
+            break;
+        }
+        case EventType::Cancel:
+            writeCancel(ts, static_cast<const CancelEvent&>(event).getOrderId());
+            break;
+        case EventType::Maintenance: {
+            const auto& e = static_cast<const MaintenanceEvent&>(event);
+            writeMaintenance(ts, e.getVehicleId(), e.getDuration());
+            break;
+        }
+        case EventType::Reroute: {
+            const auto& e = static_cast<const RerouteEvent&>(event);
+            writeReroute(ts, e.getNodeA(), e.getNodeB(), e.getNewTime());
+            break;
+        }
+    }
+}
+
+TextScenarioWriter::TextScenarioWriter()
+    : m_file(nullptr), m_buffer(kWriteBufferSize), m_used(0) {}
+
+TextScenarioWriter::~TextScenarioWriter() {
+    close();
+}
+
+bool TextScenarioWriter::open(const std::string& filename) {
+    close();
+    m_file = std::fopen(filename.c_str(), "wb");
+    if (!m_file) {
+        m_error = "Could not open file for writing: " + filename;
+        return false;
+    }
+    m_used = 0;
+    return true;
+}
+
+bool TextScenarioWriter::close() {
+    if (!m_file) return true;
+    flush();
+    bool ok = std::ferror(m_file) == 0;
+    ok = (std::fclose(m_file) == 0) && ok;
+    m_file = nullptr;
+    if (!ok) m_error = "Write error while closing scenario file";
+    return ok;
+}
+
+void TextScenarioWriter::flush() {
+    if (m_file && m_used > 0) {
+        std::fwrite(m_buffer.data(), 1, m_used, m_file);
+    }
+    m_used = 0;
+}
+
+void TextScenarioWriter::putInt(long long value) {
+    if (m_used + 24 > m_buffer.size()) flush();
+    char* begin = m_buffer.data() + m_used;
+    auto res = std::to_chars(begin, m_buffer.data() + m_buffer.size(), value);
+    m_used += res.ptr - begin;
+}
+
+void TextScenarioWriter::putDouble(double value) {
+    if (m_used + 32 > m_buffer.size()) flush();
+    char* begin = m_buffer.data() + m_used;
+    auto res = std::to_chars(begin, m_buffer.data() + m_buffer.size(), value);
+    m_used += res.ptr - begin;
+}
+
+void TextScenarioWriter::putChar(char c) {
+    if (m_used + 1 > m_buffer.size()) flush();
+    m_buffer[m_used++] = c;
+}
+
+void TextScenarioWriter::putText(const char* text) {
+    size_t len = std::strlen(text);
+    if (m_used + len > m_buffer.size()) flush();
+    std::memcpy(m_buffer.data() + m_used, text, len);
+    m_used += len;
+}
+
+void TextScenarioWriter::writeHeader(int numWarehouses, int numItems, int numVehicles) {
+    putInt(numWarehouses); putChar(' ');
+    putInt(numItems); putChar(' ');
+    putInt(numVehicles); putChar('\n');
+}
+
+void TextScenarioWriter::writeTravelRow(const std::vector<int>& row) {
+    for (size_t j = 0; j < row.size(); ++j) {
+        if (j > 0) putChar(' ');
+        putInt(row[j]);
+    }
+    putChar('\n');
+}
+
+void TextScenarioWriter::writeVehicle(int id, VehicleType type, int speed, int capacity, int homeWarehouse) {
+    bool refrigerated = (type == VehicleType::Refrigerated);
+    putInt(id);
+    putText(refrigerated ? " Refrigerated " : " Standard ");
+    putInt(speed); putChar(' ');
+    putInt(capacity); putChar(' ');
+    putInt(refrigerated ? 1 : 0); putChar(' ');
+    putInt(homeWarehouse); putChar('\n');
+}
+
+void TextScenarioWriter::writeWarehouse(int wid, const std::vector<int>& inventory) {
+    putInt(wid); putChar('\n');
+    for (size_t j = 0; j < inventory.size(); ++j) {
+        if (j > 0) putChar(' ');
+        putInt(inventory[j]);
+    }
+    putChar('\n');
+}
+
+void TextScenarioWriter::writeNodeCoords(const std::vector<std::pair<double, double>>& coords) {
+    putText("COORDS\n");
+    for (size_t node = 1; node < coords.size(); ++node) {
+        putInt(static_cast<long long>(node)); putChar(' ');
+        putDouble(coords[node].first); putChar(' ');
+        putDouble(coords[node].second); putChar('\n');
+    }
+}
+
+void TextScenarioWriter::beginEvents(long long count) {
+    putInt(count); putChar('\n');
+}
+
+void TextScenarioWriter::writeOrder(int timestamp, int orderId, int destination, int dueBy, bool isVip,
+                                    const std::vector<std::pair<int, int>>& demand) {
+    putText("R "); putInt(timestamp); putChar(' ');
+    putInt(orderId); putChar(' ');
+    putInt(destination); putChar(' ');
+    putInt(dueBy);
+    putText(isVip ? " VIP " : " STD ");
+    putInt(static_cast<long long>(demand.size())); putChar('\n');
+    for (const auto& item : demand) {
+        putInt(item.first); putChar(' ');
+        putInt(item.second); putChar('\n');
+    }
+}
+
+void TextScenarioWriter::writeRestock(int timestamp, int warehouseId,
+                                      const std::vector<std::pair<int, int>>& items) {
+    putText("S "); putInt(timestamp); putChar(' ');
+    putInt(warehouseId); putChar(' ');
+    putInt(static_cast<long long>(items.size())); putChar('\n');
+    for (const auto& item : items) {
+        putInt(item.first); putChar(' ');
+        putInt(item.second); putChar('\n');
+    }
+}
+
+void TextScenarioWriter::writeCancel(int timestamp, int orderId) {
+    putText("C "); putInt(timestamp); putChar(' ');
+    putInt(orderId); putChar('\n');
+}
+
+void TextScenarioWriter::writeMaintenance(int timestamp, int vehicleId, int duration) {
+    putText("M "); putInt(timestamp); putChar(' ');
+    putInt(vehicleId); putChar(' ');
+    putInt(duration); putChar('\n');
+}
+
+void TextScenarioWriter::writeReroute(int timestamp, int nodeA, int nodeB, int newTime) {
+    putText("U "); putInt(timestamp); putChar(' ');
+    putInt(nodeA); putChar(' ');
+    putInt(nodeB); putChar(' ');
+    putInt(newTime); putChar('\n');
+}
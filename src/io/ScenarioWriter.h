@@ -0,0 +1,82 @@
+#ifndef SCENARIOWRITER_H
+#define SCENARIOWRITER_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "models/Event.h"
+#include "models/Vehicle.h"
+
+// Sequential writer for scenario files. Sections must be written in file
+// order: header, W travel-matrix rows, V vehicles, W warehouses, optional
+// node coordinates, then the event count followed by exactly that many events.
+class ScenarioWriter {
+public:
+    virtual ~ScenarioWriter() = default;
+
+    virtual bool open(const std::string& filename) = 0;
+    virtual bool close() = 0;
+
+    virtual void writeHeader(int numWarehouses, int numItems, int numVehicles) = 0;
+    virtual void writeTravelRow(const std::vector<int>& row) = 0;
+    virtual void writeVehicle(int id, VehicleType type, int speed, int capacity, int homeWarehouse) = 0;
+    virtual void writeWarehouse(int wid, const std::vector<int>& inventory) = 0;
+    // coords[node] for nodes 1..W (index 0 unused). Formats without a
+    // coordinate section drop them; readers fall back to a computed layout.
+    virtual void writeNodeCoords(const std::vector<std::pair<double, double>>& coords) { (void)coords; }
+    virtual void beginEvents(long long count) = 0;
+
+    virtual void writeOrder(int timestamp, int orderId, int destination, int dueBy, bool isVip,
+                            const std::vector<std::pair<int, int>>& demand) = 0;
+    virtual void writeRestock(int timestamp, int warehouseId,
+                              const std::vector<std::pair<int, int>>& items) = 0;
+    virtual void writeCancel(int timestamp, int orderId) = 0;
+    virtual void writeMaintenance(int timestamp, int vehicleId, int duration) = 0;
+    virtual void writeReroute(int timestamp, int nodeA, int nodeB, int newTime) = 0;
+
+    // Dispatches a parsed event to the matching write call
+    void writeEvent(const Event& event);
+
+    std::string getError() const { return m_error; }
+
+protected:
+    std::string m_error;
+};
+
+// Writes the plain-text R/S/C/M/U format read by InputParser
+class TextScenarioWriter : public ScenarioWriter {
+public:
+    TextScenarioWriter();
+    ~TextScenarioWriter() override;
+
+    bool open(const std::string& filename) override;
+    bool close() override;
+
+    void writeHeader(int numWarehouses, int numItems, int numVehicles) override;
+    void writeTravelRow(const std::vector<int>& row) override;
+    void writeVehicle(int id, VehicleType type, int speed, int capacity, int homeWarehouse) override;
+    void writeWarehouse(int wid, const std::vector<int>& inventory) override;
+    void writeNodeCoords(const std::vector<std::pair<double, double>>& coords) override;
+    void beginEvents(long long count) override;
+
+    void writeOrder(int timestamp, int orderId, int destination, int dueBy, bool isVip,
+                    const std::vector<std::pair<int, int>>& demand) override;
+    void writeRestock(int timestamp, int warehouseId,
+                      const std::vector<std::pair<int, int>>& items) override;
+    void writeCancel(int timestamp, int orderId) override;
+    void writeMaintenance(int timestamp, int vehicleId, int duration) override;
+    void writeReroute(int timestamp, int nodeA, int nodeB, int newTime) override;
+
+private:
+    void putInt(long long value);
+    void putDouble(double value);
+    void putChar(char c);
+    void putText(const char* text);
+    void flush();
+
+    std::FILE* m_file;
+    std::vector<char> m_buffer;
+    size_t m_used;
+};
+
+#endif // SCENARIOWRITER_H
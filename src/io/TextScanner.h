@@ -0,0 +1,97 @@
+#ifndef TEXTSCANNER_H
+#define TEXTSCANNER_H
+
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+
+// Line/field tokenizer over an in-memory buffer. Lines split on '\n' exactly
+// like std::getline; within a line, fields are read the way operator>> reads
+// them (leading whitespace skipped, '\r' counts as whitespace). Nothing is
+// copied or allocated.
+class TextScanner {
+public:
+    // firstLine is the number of lines before data, for error positions
+    TextScanner(const char* data, size_t size, size_t firstLine = 0)
+        : m_next(data), m_end(data + size), m_lineStart(data), m_lineEnd(data),
+          m_cursor(data), m_line(firstLine) {}
+
+    // Moves to the next line. With skipBlank, zero-length lines are passed over.
+    // Returns false at end of input.
+    bool nextLine(bool skipBlank) {
+        do {
+            if (m_next >= m_end) return false;
+            m_lineStart = m_next;
+            const void* nl = std::memchr(m_next, '\n', static_cast<size_t>(m_end - m_next));
+            m_lineEnd = nl ? static_cast<const char*>(nl) : m_end;
+            m_next = nl ? m_lineEnd + 1 : m_end;
+            ++m_line;
+        } while (skipBlank && m_lineEnd == m_lineStart);
+        m_cursor = m_lineStart;
+        return true;
+    }
+
+    bool readInt(int& value) {
+        skipSpaces();
+        const char* p = m_cursor;
+        // operator>> accepts an explicit plus sign, from_chars does not
+        if (p < m_lineEnd && *p == '+') ++p;
+        auto [ptr, ec] = std::from_chars(p, m_lineEnd, value);
+        if (ec != std::errc()) return false;
+        m_cursor = ptr;
+        return true;
+    }
+
+    bool readDouble(double& value) {
+        skipSpaces();
+        const char* p = m_cursor;
+        if (p < m_lineEnd && *p == '+') ++p;
+        auto [ptr, ec] = std::from_chars(p, m_lineEnd, value);
+        if (ec != std::errc()) return false;
+        m_cursor = ptr;
+        return true;
+    }
+
+    bool readWord(std::string_view& word) {
+        skipSpaces();
+        const char* start = m_cursor;
+        while (m_cursor < m_lineEnd && !isSpace(*m_cursor)) ++m_cursor;
+        word = std::string_view(start, static_cast<size_t>(m_cursor - start));
+        return !word.empty();
+    }
+
+    bool readChar(char& c) {
+        skipSpaces();
+        if (m_cursor >= m_lineEnd) return false;
+        c = *m_cursor++;
+        return true;
+    }
+
+    // Start of the current line, and the unread input after it
+    const char* lineStart() const { return m_lineStart; }
+    const char* remaining() const { return m_next; }
+    const char* end() const { return m_end; }
+
+    size_t lineNumber() const { return m_line; }
+    // 1-based column of the next unread character
+    size_t column() const { return static_cast<size_t>(m_cursor - m_lineStart) + 1; }
+
+private:
+    static bool isSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+    }
+
+    void skipSpaces() {
+        while (m_cursor < m_lineEnd && isSpace(*m_cursor)) ++m_cursor;
+    }
+
+    const char* m_next;
+    const char* m_end;
+    const char* m_lineStart;
+    const char* m_lineEnd;
+    const char* m_cursor;
+    size_t m_line;
+};
+
+#endif // TEXTSCANNER_H
@@ -116,11 +116,27 @@ private:
 // Smart pointer type for polymorphic events
 using EventPtr = std::shared_ptr<Event>;
 
-// Comparator for priority queue
-struct EventComparator {
-    bool operator()(const EventPtr& a, const EventPtr& b) const {
-        return a->getTimestamp() > b->getTimestamp();
+// Queue entry that keeps insertion (file) order among equal timestamps
+struct SequencedEvent {
+    EventPtr event;
+    long long sequence;
+};
+
+struct SequencedEventComparator {
+    bool operator()(const SequencedEvent& a, const SequencedEvent& b) const {
+        int ta = a.event->getTimestamp(), tb = b.event->getTimestamp();
+        return ta != tb ? ta > tb : a.sequence > b.sequence;
     }
 };
 
+// Events pulled lazily in timestamp order (e.g. streamed from a trace file)
+class EventSource {
+public:
+    virtual ~EventSource() = default;
+    
+    // Next event, or nullptr once the source is exhausted or has failed
+    virtual EventPtr next() = 0;
+    virtual std::string getError() const { return std::string(); }
+};
+
 #endif // EVENT_H
@@ -5,7 +5,8 @@ Order::Order()
     : m_id(0), m_requestTime(0), m_dueBy(0), m_destination(0),
       m_priority(PriorityClass::Standard), m_status(OrderStatus::Waiting),
       m_value(0), m_assignedWarehouse(-1), m_assignedVehicle(-1),
-      m_assignTime(-1), m_dispatchTime(-1), m_finishTime(-1) {}
+      m_assignTime(-1), m_dispatchTime(-1), m_finishTime(-1),
+      m_lastBlock(BlockReason::None), m_blockCounts{} {}
 
 Order::Order(int id, int requestTime, int dueBy, int destination,
              PriorityClass priority, double value,
@@ -14,7 +15,8 @@ Order::Order(int id, int requestTime, int dueBy, int destination,
       m_destination(destination), m_priority(priority),
       m_status(OrderStatus::Waiting), m_value(value), m_demand(demand),
       m_assignedWarehouse(-1), m_assignedVehicle(-1),
-      m_assignTime(-1), m_dispatchTime(-1), m_finishTime(-1) {}
+      m_assignTime(-1), m_dispatchTime(-1), m_finishTime(-1),
+      m_lastBlock(BlockReason::None), m_blockCounts{} {}
 
 double Order::calculatePriority(int currentTime) const {
     // Priority = α * OrderValue / (β * (CurrentTime − RT + 1)) + γ * DeadlineUrgency − δ * SizePenalty
@@ -63,3 +65,20 @@ std::string Order::getStatusString() const {
 std::string Order::getPriorityString() const {
     return m_priority == PriorityClass::VIP ? "VIP" : "Standard";
 }
+
+int Order::getBlockedAttempts() const {
+    int total = 0;
+    for (int reason = static_cast<int>(BlockReason::NoStock); reason < BlockReasonCount; ++reason) {
+        total += m_blockCounts[reason];
+    }
+    return total;
+}
+
+std::string Order::getBlockReasonString() const {
+    switch (m_lastBlock) {
+        case BlockReason::NoStock: return "No stock";
+        case BlockReason::NoVehicle: return "No vehicle";
+        case BlockReason::NoCapacity: return "Capacity";
+        default: return "";
+    }
+}
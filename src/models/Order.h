@@ -6,6 +6,10 @@
 
 enum class PriorityClass { VIP, Standard };
 enum class OrderStatus { Waiting, Assigned, InTransit, Delivered, Canceled, PartiallyFulfilled };
+// Why the scheduler passed over a waiting order
+enum class BlockReason { None, NoStock, NoVehicle, NoCapacity };
+// Size of per-reason arrays; follows the last enumerator
+const int BlockReasonCount = static_cast<int>(BlockReason::NoCapacity) + 1;
 
 class Order {
 public:
@@ -37,6 +41,15 @@ public:
     void setDispatchTime(int time) { m_dispatchTime = time; }
     void setFinishTime(int time) { m_finishTime = time; }
     
+    // Last reason the scheduler skipped this order, and attempts skipped per reason
+    BlockReason getLastBlockReason() const { return m_lastBlock; }
+    int getBlockCount(BlockReason reason) const { return m_blockCounts[static_cast<int>(reason)]; }
+    int getBlockedAttempts() const;
+    void recordBlock(BlockReason reason) {
+        m_lastBlock = reason;
+        m_blockCounts[static_cast<int>(reason)]++;
+    }
+    
     // Priority calculation
     double calculatePriority(int currentTime) const;
     
@@ -44,6 +57,7 @@ public:
     int getTotalQuantity() const;
     std::string getStatusString() const;
     std::string getPriorityString() const;
+    std::string getBlockReasonString() const;
     
 private:
     int m_id;
@@ -60,6 +74,9 @@ private:
     int m_assignTime;
     int m_dispatchTime;
     int m_finishTime;
+    
+    BlockReason m_lastBlock;
+    int m_blockCounts[BlockReasonCount];
 };
 
 #endif // ORDER_H
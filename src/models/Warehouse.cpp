@@ -1,10 +1,10 @@
 #include "Warehouse.h"
 #include <algorithm>
 
-Warehouse::Warehouse() : m_id(0), m_locationNode(0) {}
+Warehouse::Warehouse() : m_id(0), m_locationNode(0), m_totalItems(0) {}
 
 Warehouse::Warehouse(int id, int locationNode) 
-    : m_id(id), m_locationNode(locationNode) {}
+    : m_id(id), m_locationNode(locationNode), m_totalItems(0) {}
 
 int Warehouse::getInventory(int itemId) const {
     auto it = m_inventory.find(itemId);
@@ -12,11 +12,14 @@ int Warehouse::getInventory(int itemId) const {
 }
 
 void Warehouse::setInventory(int itemId, int quantity) {
-    m_inventory[itemId] = quantity;
+    int& current = m_inventory[itemId];
+    m_totalItems += quantity - current;
+    current = quantity;
 }
 
 void Warehouse::addInventory(int itemId, int quantity) {
     m_inventory[itemId] += quantity;
+    m_totalItems += quantity;
 }
 
 bool Warehouse::removeInventory(int itemId, int quantity) {
@@ -25,6 +28,7 @@ bool Warehouse::removeInventory(int itemId, int quantity) {
         return false;
     }
     it->second -= quantity;
+    m_totalItems -= quantity;
     return true;
 }
 
@@ -52,14 +56,6 @@ int Warehouse::getNextDispatch() {
     return orderId;
 }
 
-int Warehouse::getTotalItems() const {
-    int total = 0;
-    for (const auto& item : m_inventory) {
-        total += item.second;
-    }
-    return total;
-}
-
 std::vector<std::pair<int, int>> Warehouse::getLowStockItems(int threshold) const {
     std::vector<std::pair<int, int>> lowStock;
     for (const auto& item : m_inventory) {
@@ -30,13 +30,14 @@ public:
     bool hasDispatchPending() const { return !m_dispatchQueue.empty(); }
     
     // Statistics
-    int getTotalItems() const;
+    int getTotalItems() const { return m_totalItems; }
     std::vector<std::pair<int, int>> getLowStockItems(int threshold = 10) const;
     
 private:
     int m_id;
     int m_locationNode;
     std::unordered_map<int, int> m_inventory; // ItemID -> Quantity
+    int m_totalItems;                          // Sum of m_inventory
     std::queue<int> m_dispatchQueue; // Order IDs pending dispatch
 };
 
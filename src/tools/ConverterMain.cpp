@@ -0,0 +1,99 @@
+#include <iostream>
+#include <memory>
+#include <string>
+#include "io/BinaryScenario.h"
+#include "io/InputParser.h"
+#include "io/ScenarioWriter.h"
+
+namespace {
+
+void printUsage() {
+    std::cout <<
+        "Usage: ScenarioConverter <input> <output> [--to text|binary]\n"
+        "\n"
+        "Converts a scenario between the text and binary formats. The input format\n"
+        "is detected automatically; the output is binary when --to binary is given\n"
+        "or the output name ends in .wdsb, text otherwise.\n";
+}
+
+bool endsWith(const std::string& s, const std::string& suffix) {
+    return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+void writeScenario(const InputParser& parser, ScenarioWriter& writer) {
+    int w = parser.getNumWarehouses();
+    int n = parser.getNumItems();
+    writer.writeHeader(w, n, parser.getNumVehicles());
+
+    const auto& travel = parser.getTravelTimes();
+    std::vector<int> row(w);
+    for (int i = 1; i <= w; ++i) {
+        for (int j = 1; j <= w; ++j) row[j - 1] = travel[i][j];
+        writer.writeTravelRow(row);
+    }
+
+    for (const auto& [id, v] : parser.getVehicles()) {
+        writer.writeVehicle(id, v.getType(), v.getSpeed(), v.getCapacity(), v.getHomeWarehouse());
+    }
+
+    std::vector<int> inventory(n);
+    for (const auto& [wid, warehouse] : parser.getWarehouses()) {
+        for (int j = 1; j <= n; ++j) inventory[j - 1] = warehouse.getInventory(j);
+        writer.writeWarehouse(wid, inventory);
+    }
+    if (!parser.getNodeCoords().empty()) writer.writeNodeCoords(parser.getNodeCoords());
+
+    writer.beginEvents(static_cast<long long>(parser.getEvents().size()));
+    for (const auto& event : parser.getEvents()) {
+        writer.writeEvent(*event);
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string input;
+    std::string output;
+    std::string format;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") { printUsage(); return 0; }
+        else if (arg == "--to" && i + 1 < argc) format = argv[++i];
+        else if (input.empty()) input = arg;
+        else if (output.empty()) output = arg;
+        else { printUsage(); return 2; }
+    }
+    if (input.empty() || output.empty()) {
+        printUsage();
+        return 2;
+    }
+    if (format.empty()) format = endsWith(output, ".wdsb") ? "binary" : "text";
+
+    std::unique_ptr<ScenarioWriter> writer;
+    if (format == "text") {
+        writer = std::make_unique<TextScenarioWriter>();
+    } else if (format == "binary") {
+        writer = std::make_unique<BinaryScenarioWriter>();
+    } else {
+        std::cerr << "Unknown format: " << format << "\n";
+        return 2;
+    }
+
+    InputParser parser;
+    if (!parser.parse(input)) {
+        std::cerr << input << ": " << parser.getError() << "\n";
+        return 1;
+    }
+
+    if (!writer->open(output)) {
+        std::cerr << writer->getError() << "\n";
+        return 1;
+    }
+    writeScenario(parser, *writer);
+    if (!writer->close()) {
+        std::cerr << writer->getError() << "\n";
+        return 1;
+    }
+    return 0;
+}
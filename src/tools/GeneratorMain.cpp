@@ -0,0 +1,146 @@
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include "ScenarioGenerator.h"
+#include "io/BinaryScenario.h"
+#include "io/ScenarioWriter.h"
+
+namespace {
+
+void printUsage() {
+    std::cout <<
+        "Usage: ScenarioGenerator -o <file> [options]\n"
+        "\n"
+        "Size:\n"
+        "  --warehouses W        Number of warehouses / network nodes (default 10)\n"
+        "  --items N             Number of item types (default 20)\n"
+        "  --vehicles V          Number of vehicles (default 20)\n"
+        "  --events E            Number of events (default 1000)\n"
+        "  --seed S              Random seed; same seed + options = same file (default 1)\n"
+        "  --format F            Output format: text | binary (default text)\n"
+        "\n"
+        "Network:\n"
+        "  --topology T          grid | clustered | geometric (default grid)\n"
+        "  --clusters K          Cluster count for clustered topology (default 8)\n"
+        "  --max-travel T        Travel time across the whole map (default 60)\n"
+        "\n"
+        "Arrivals:\n"
+        "  --arrival P           poisson | bursty | diurnal (default poisson)\n"
+        "  --rate R              Mean events per timestep (default 2)\n"
+        "  --burst-factor F      Bursty: rate multiplier inside a burst (default 8)\n"
+        "  --burst-fraction F    Bursty: share of time in bursts (default 0.1)\n"
+        "  --burst-length L      Bursty: mean burst length in timesteps (default 20)\n"
+        "  --day-length L        Diurnal: timesteps per day (default 1440)\n"
+        "  --day-amplitude A     Diurnal: 0..1 day/night swing (default 0.8)\n"
+        "\n"
+        "Orders:\n"
+        "  --vip-ratio R         Fraction of VIP orders (default 0.2)\n"
+        "  --lines MIN MAX       Demand lines per order (default 1 4)\n"
+        "  --size-dist D         uniform | geometric | lognormal (default geometric)\n"
+        "  --mean-qty Q          Mean quantity per demand line (default 8)\n"
+        "  --max-qty Q           Quantity cap per demand line (default 100)\n"
+        "  --item-skew S         Zipf exponent of item popularity (default 0.8)\n"
+        "  --slack MIN MAX       DueBy slack after arrival (default 10 80)\n"
+        "\n"
+        "Other events (fraction of all events):\n"
+        "  --cancel-rate R       (default 0.03)\n"
+        "  --maintenance-rate R  (default 0.01)\n"
+        "  --restock-rate R      (default 0.05)\n"
+        "  --reroute-rate R      (default 0.01)\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    ScenarioGenerator::Config config;
+    std::string output;
+    std::string format = "text";
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto next = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << "\n";
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+        auto nextInt = [&]() { return std::atoi(next().c_str()); };
+        auto nextDouble = [&]() { return std::atof(next().c_str()); };
+
+        if (arg == "-h" || arg == "--help") { printUsage(); return 0; }
+        else if (arg == "-o" || arg == "--output") output = next();
+        else if (arg == "--format") format = next();
+        else if (arg == "--seed") config.seed = std::strtoull(next().c_str(), nullptr, 10);
+        else if (arg == "--warehouses") config.numWarehouses = nextInt();
+        else if (arg == "--items") config.numItems = nextInt();
+        else if (arg == "--vehicles") config.numVehicles = nextInt();
+        else if (arg == "--events") config.numEvents = std::atoll(next().c_str());
+        else if (arg == "--clusters") config.numClusters = nextInt();
+        else if (arg == "--max-travel") config.maxTravelTime = nextInt();
+        else if (arg == "--rate") config.arrivalRate = nextDouble();
+        else if (arg == "--burst-factor") config.burstFactor = nextDouble();
+        else if (arg == "--burst-fraction") config.burstFraction = nextDouble();
+        else if (arg == "--burst-length") config.burstLength = nextDouble();
+        else if (arg == "--day-length") config.diurnalPeriod = nextDouble();
+        else if (arg == "--day-amplitude") config.diurnalAmplitude = nextDouble();
+        else if (arg == "--vip-ratio") config.vipRatio = nextDouble();
+        else if (arg == "--lines") { config.minLines = nextInt(); config.maxLines = nextInt(); }
+        else if (arg == "--mean-qty") config.meanQuantity = nextDouble();
+        else if (arg == "--max-qty") config.maxQuantity = nextInt();
+        else if (arg == "--item-skew") config.itemSkew = nextDouble();
+        else if (arg == "--slack") { config.minSlack = nextInt(); config.maxSlack = nextInt(); }
+        else if (arg == "--cancel-rate") config.cancelRate = nextDouble();
+        else if (arg == "--maintenance-rate") config.maintenanceRate = nextDouble();
+        else if (arg == "--restock-rate") config.restockRate = nextDouble();
+        else if (arg == "--reroute-rate") config.rerouteRate = nextDouble();
+        else if (arg == "--topology") {
+            if (!ScenarioGenerator::parseTopology(next(), config.topology)) {
+                std::cerr << "Unknown topology\n";
+                return 2;
+            }
+        } else if (arg == "--arrival") {
+            if (!ScenarioGenerator::parseArrivalProcess(next(), config.arrivals)) {
+                std::cerr << "Unknown arrival process\n";
+                return 2;
+            }
+        } else if (arg == "--size-dist") {
+            if (!ScenarioGenerator::parseSizeDistribution(next(), config.sizeDistribution)) {
+                std::cerr << "Unknown size distribution\n";
+                return 2;
+            }
+        } else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            printUsage();
+            return 2;
+        }
+    }
+
+    if (output.empty()) {
+        printUsage();
+        return 2;
+    }
+
+    std::unique_ptr<ScenarioWriter> writer;
+    if (format == "text") {
+        writer = std::make_unique<TextScenarioWriter>();
+    } else if (format == "binary") {
+        writer = std::make_unique<BinaryScenarioWriter>();
+    } else {
+        std::cerr << "Unknown format: " << format << "\n";
+        return 2;
+    }
+
+    if (!writer->open(output)) {
+        std::cerr << writer->getError() << "\n";
+        return 1;
+    }
+
+    ScenarioGenerator generator(config);
+    if (!generator.generate(*writer)) {
+        std::cerr << generator.getError() << "\n";
+        return 1;
+    }
+    return 0;
+}
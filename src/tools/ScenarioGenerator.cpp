@@ -0,0 +1,351 @@
+#include "ScenarioGenerator.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+const double kPi = 3.14159265358979323846;
+
+uint64_t splitmix64(uint64_t& x) {
+    uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+}
+
+ScenarioGenerator::ScenarioGenerator(const Config& config)
+    : m_config(config), m_distanceScale(1.0), m_inBurst(false), m_burstEnds(0) {
+    uint64_t s = config.seed;
+    for (auto& word : m_state) word = splitmix64(s);
+}
+
+uint64_t ScenarioGenerator::nextRandom() {
+    uint64_t result = rotl(m_state[1] * 5, 7) * 9;
+    uint64_t t = m_state[1] << 17;
+    m_state[2] ^= m_state[0];
+    m_state[3] ^= m_state[1];
+    m_state[1] ^= m_state[2];
+    m_state[0] ^= m_state[3];
+    m_state[2] ^= t;
+    m_state[3] = rotl(m_state[3], 45);
+    return result;
+}
+
+double ScenarioGenerator::uniform() {
+    return (nextRandom() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+int ScenarioGenerator::uniformInt(int lo, int hi) {
+    if (hi <= lo) return lo;
+    uint64_t span = static_cast<uint64_t>(hi - lo) + 1;
+    return lo + static_cast<int>(nextRandom() % span);
+}
+
+double ScenarioGenerator::exponential(double rate) {
+    return -std::log(1.0 - uniform()) / rate;
+}
+
+double ScenarioGenerator::normal() {
+    // Box-Muller; the second variate is discarded to keep the stream simple
+    double u1 = 1.0 - uniform();
+    double u2 = uniform();
+    return std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * kPi * u2);
+}
+
+bool ScenarioGenerator::generate(ScenarioWriter& writer) {
+    const Config& c = m_config;
+    if (c.numWarehouses < 1 || c.numItems < 1 || c.numVehicles < 0 || c.numEvents < 0) {
+        m_error = "W and N must be positive, V and event count non-negative";
+        return false;
+    }
+    if (c.arrivalRate <= 0) {
+        m_error = "Arrival rate must be positive";
+        return false;
+    }
+
+    placeNodes();
+    buildItemPopularity();
+
+    writer.writeHeader(c.numWarehouses, c.numItems, c.numVehicles);
+    writeMatrix(writer);
+    writeVehicles(writer);
+    writeWarehouses(writer);
+    writeCoords(writer);
+    writeEvents(writer);
+
+    if (!writer.close()) {
+        m_error = writer.getError();
+        return false;
+    }
+    return true;
+}
+
+void ScenarioGenerator::placeNodes() {
+    int w = m_config.numWarehouses;
+    m_nodeX.assign(w + 1, 0.0);
+    m_nodeY.assign(w + 1, 0.0);
+
+    switch (m_config.topology) {
+        case Topology::Grid: {
+            int side = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(w))));
+            for (int i = 1; i <= w; ++i) {
+                m_nodeX[i] = ((i - 1) % side + 0.5) / side;
+                m_nodeY[i] = ((i - 1) / side + 0.5) / side;
+            }
+            m_distanceScale = m_config.maxTravelTime / 2.0;   // Manhattan diameter of the unit square
+            break;
+        }
+        case Topology::Clustered: {
+            int k = std::max(1, m_config.numClusters);
+            std::vector<double> cx(k), cy(k);
+            for (int i = 0; i < k; ++i) {
+                cx[i] = 0.1 + 0.8 * uniform();
+                cy[i] = 0.1 + 0.8 * uniform();
+            }
+            for (int i = 1; i <= w; ++i) {
+                int cluster = uniformInt(0, k - 1);
+                m_nodeX[i] = std::clamp(cx[cluster] + 0.05 * normal(), 0.0, 1.0);
+                m_nodeY[i] = std::clamp(cy[cluster] + 0.05 * normal(), 0.0, 1.0);
+            }
+            m_distanceScale = m_config.maxTravelTime / std::sqrt(2.0);
+            break;
+        }
+        case Topology::RandomGeometric: {
+            for (int i = 1; i <= w; ++i) {
+                m_nodeX[i] = uniform();
+                m_nodeY[i] = uniform();
+            }
+            m_distanceScale = m_config.maxTravelTime / std::sqrt(2.0);
+            break;
+        }
+    }
+}
+
+int ScenarioGenerator::travelTime(int from, int to) const {
+    if (from == to) return 0;
+    double dx = m_nodeX[from] - m_nodeX[to];
+    double dy = m_nodeY[from] - m_nodeY[to];
+    double d = (m_config.topology == Topology::Grid)
+        ? std::fabs(dx) + std::fabs(dy)
+        : std::sqrt(dx * dx + dy * dy);
+    return std::max(1, static_cast<int>(std::lround(d * m_distanceScale)));
+}
+
+void ScenarioGenerator::buildItemPopularity() {
+    int n = m_config.numItems;
+    m_itemCdf.resize(n);
+    double total = 0;
+    for (int i = 0; i < n; ++i) {
+        total += 1.0 / std::pow(i + 1.0, m_config.itemSkew);
+        m_itemCdf[i] = total;
+    }
+    for (double& v : m_itemCdf) v /= total;
+}
+
+int ScenarioGenerator::sampleItem() {
+    double u = uniform();
+    auto it = std::upper_bound(m_itemCdf.begin(), m_itemCdf.end(), u);
+    int index = static_cast<int>(std::min<ptrdiff_t>(it - m_itemCdf.begin(), m_itemCdf.size() - 1));
+    return index + 1;
+}
+
+int ScenarioGenerator::sampleQuantity() {
+    double mean = std::max(1.0, m_config.meanQuantity);
+    double q = 1;
+    switch (m_config.sizeDistribution) {
+        case SizeDistribution::Uniform:
+            q = uniformInt(1, static_cast<int>(2 * mean - 1));
+            break;
+        case SizeDistribution::Geometric: {
+            double p = 1.0 / mean;
+            q = (p >= 1.0) ? 1 : 1 + std::floor(std::log(1.0 - uniform()) / std::log(1.0 - p));
+            break;
+        }
+        case SizeDistribution::LogNormal: {
+            const double sigma = 0.75;
+            double mu = std::log(mean) - sigma * sigma / 2;
+            q = std::round(std::exp(mu + sigma * normal()));
+            break;
+        }
+    }
+    return static_cast<int>(std::clamp(q, 1.0, static_cast<double>(std::max(1, m_config.maxQuantity))));
+}
+
+double ScenarioGenerator::rateAt(double t) const {
+    double phase = 2.0 * kPi * t / m_config.diurnalPeriod;
+    // Trough at t = 0 ("midnight"), peak half a period later
+    return m_config.arrivalRate * (1.0 - m_config.diurnalAmplitude * std::cos(phase));
+}
+
+double ScenarioGenerator::nextArrivalTime(double now) {
+    const Config& c = m_config;
+    switch (c.arrivals) {
+        case ArrivalProcess::Poisson:
+            return now + exponential(c.arrivalRate);
+
+        case ArrivalProcess::Diurnal: {
+            // Thinning of a homogeneous process at the peak rate
+            double peak = c.arrivalRate * (1.0 + c.diurnalAmplitude);
+            double t = now;
+            for (;;) {
+                t += exponential(peak);
+                if (uniform() * peak < rateAt(t)) return t;
+            }
+        }
+
+        case ArrivalProcess::Bursty: {
+            // Two-state Markov-modulated Poisson process, scaled so the long-run
+            // average matches arrivalRate
+            double f = std::clamp(c.burstFraction, 0.001, 0.999);
+            double calmRate = c.arrivalRate / (1.0 - f + c.burstFactor * f);
+            double calmLength = c.burstLength * (1.0 - f) / f;
+            double t = now;
+            if (m_burstEnds < t) m_burstEnds = t + exponential(1.0 / calmLength);
+            for (;;) {
+                double rate = m_inBurst ? calmRate * c.burstFactor : calmRate;
+                double next = t + exponential(rate);
+                if (next < m_burstEnds) return next;
+                t = m_burstEnds;
+                m_inBurst = !m_inBurst;
+                m_burstEnds = t + exponential(1.0 / (m_inBurst ? c.burstLength : calmLength));
+            }
+        }
+    }
+    return now + 1.0;
+}
+
+void ScenarioGenerator::writeMatrix(ScenarioWriter& writer) {
+    int w = m_config.numWarehouses;
+    std::vector<int> row(w);
+    for (int i = 1; i <= w; ++i) {
+        for (int j = 1; j <= w; ++j) {
+            row[j - 1] = travelTime(i, j);
+        }
+        writer.writeTravelRow(row);
+    }
+}
+
+void ScenarioGenerator::writeVehicles(ScenarioWriter& writer) {
+    for (int vid = 1; vid <= m_config.numVehicles; ++vid) {
+        VehicleType type = (uniform() < m_config.refrigeratedRatio)
+            ? VehicleType::Refrigerated : VehicleType::Standard;
+        int speed = uniformInt(1, 4);
+        int capacity = uniformInt(60, 150);
+        int home = (vid - 1) % m_config.numWarehouses + 1;   // Round-robin so every warehouse gets a fleet
+        writer.writeVehicle(vid, type, speed, capacity, home);
+    }
+}
+
+void ScenarioGenerator::writeWarehouses(ScenarioWriter& writer) {
+    std::vector<int> inventory(m_config.numItems);
+    for (int wid = 1; wid <= m_config.numWarehouses; ++wid) {
+        for (int& qty : inventory) {
+            qty = uniformInt(m_config.minStock, m_config.maxStock);
+        }
+        writer.writeWarehouse(wid, inventory);
+    }
+}
+
+void ScenarioGenerator::writeCoords(ScenarioWriter& writer) {
+    // The unit-square positions the travel times were derived from
+    std::vector<std::pair<double, double>> coords(m_nodeX.size());
+    for (size_t i = 1; i < coords.size(); ++i) coords[i] = {m_nodeX[i], m_nodeY[i]};
+    writer.writeNodeCoords(coords);
+}
+
+void ScenarioGenerator::writeEvents(ScenarioWriter& writer) {
+    const Config& c = m_config;
+    writer.beginEvents(c.numEvents);
+
+    // Cancels target one of the most recent orders
+    const size_t kRecentOrders = 256;
+    std::vector<int> recentOrders;
+    recentOrders.reserve(kRecentOrders);
+    size_t recentNext = 0;
+
+    std::vector<std::pair<int, int>> lines;
+    int nextOrderId = 1;
+    double clock = 1.0;
+
+    double cancelCut = c.cancelRate;
+    double maintCut = cancelCut + c.maintenanceRate;
+    double restockCut = maintCut + c.restockRate;
+    double rerouteCut = restockCut + c.rerouteRate;
+
+    for (long long n = 0; n < c.numEvents; ++n) {
+        clock = nextArrivalTime(clock);
+        int ts = static_cast<int>(clock);
+        double kind = uniform();
+
+        if (kind < cancelCut && !recentOrders.empty()) {
+            writer.writeCancel(ts, recentOrders[uniformInt(0, static_cast<int>(recentOrders.size()) - 1)]);
+        } else if (kind >= cancelCut && kind < maintCut && c.numVehicles > 0) {
+            writer.writeMaintenance(ts, uniformInt(1, c.numVehicles), uniformInt(3, 20));
+        } else if (kind >= maintCut && kind < restockCut) {
+            lines.clear();
+            int k = uniformInt(1, std::min(5, c.numItems));
+            for (int j = 0; j < k; ++j) {
+                lines.push_back({uniformInt(1, c.numItems), uniformInt(c.minStock / 2, c.maxStock / 2)});
+            }
+            writer.writeRestock(ts, uniformInt(1, c.numWarehouses), lines);
+        } else if (kind >= restockCut && kind < rerouteCut && c.numWarehouses > 1) {
+            int a = uniformInt(1, c.numWarehouses);
+            int b = uniformInt(1, c.numWarehouses - 1);
+            if (b >= a) ++b;
+            int newTime = std::max(1, static_cast<int>(travelTime(a, b) * (0.5 + 1.5 * uniform())));
+            writer.writeReroute(ts, a, b, newTime);
+        } else {
+            lines.clear();
+            int k = uniformInt(std::max(1, c.minLines), std::max(1, std::min(c.maxLines, c.numItems)));
+            for (int j = 0; j < k; ++j) {
+                int item = sampleItem();
+                int qty = sampleQuantity();
+                auto dup = std::find_if(lines.begin(), lines.end(),
+                    [item](const std::pair<int, int>& l) { return l.first == item; });
+                if (dup != lines.end()) dup->second += qty;
+                else lines.push_back({item, qty});
+            }
+
+            int orderId = nextOrderId++;
+            int dest = uniformInt(1, c.numWarehouses);
+            int dueBy = ts + uniformInt(c.minSlack, c.maxSlack);
+            bool vip = uniform() < c.vipRatio;
+            writer.writeOrder(ts, orderId, dest, dueBy, vip, lines);
+
+            if (recentOrders.size() < kRecentOrders) {
+                recentOrders.push_back(orderId);
+            } else {
+                recentOrders[recentNext] = orderId;
+                recentNext = (recentNext + 1) % kRecentOrders;
+            }
+        }
+    }
+}
+
+bool ScenarioGenerator::parseTopology(const std::string& name, Topology& out) {
+    if (name == "grid") out = Topology::Grid;
+    else if (name == "clustered") out = Topology::Clustered;
+    else if (name == "geometric" || name == "random-geometric") out = Topology::RandomGeometric;
+    else return false;
+    return true;
+}
+
+bool ScenarioGenerator::parseArrivalProcess(const std::string& name, ArrivalProcess& out) {
+    if (name == "poisson") out = ArrivalProcess::Poisson;
+    else if (name == "bursty") out = ArrivalProcess::Bursty;
+    else if (name == "diurnal") out = ArrivalProcess::Diurnal;
+    else return false;
+    return true;
+}
+
+bool ScenarioGenerator::parseSizeDistribution(const std::string& name, SizeDistribution& out) {
+    if (name == "uniform") out = SizeDistribution::Uniform;
+    else if (name == "geometric") out = SizeDistribution::Geometric;
+    else if (name == "lognormal") out = SizeDistribution::LogNormal;
+    else return false;
+    return true;
+}
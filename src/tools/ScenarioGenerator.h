@@ -0,0 +1,111 @@
+#ifndef SCENARIOGENERATOR_H
+#define SCENARIOGENERATOR_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "io/ScenarioWriter.h"
+
+// Synthetic workload generator. Output is fully determined by the config
+// (including the seed): all randomness comes from the built-in xoshiro
+// generator, never from std:: distributions whose output differs between
+// standard libraries. Events are written in non-decreasing timestamp order.
+class ScenarioGenerator {
+public:
+    enum class Topology { Grid, Clustered, RandomGeometric };
+    enum class ArrivalProcess { Poisson, Bursty, Diurnal };
+    enum class SizeDistribution { Uniform, Geometric, LogNormal };
+
+    struct Config {
+        uint64_t seed = 1;
+
+        int numWarehouses = 10;
+        int numItems = 20;
+        int numVehicles = 20;
+        long long numEvents = 1000;
+
+        // Network
+        Topology topology = Topology::Grid;
+        int numClusters = 8;            // Clustered topology only
+        int maxTravelTime = 60;         // Travel time across the whole map
+
+        // Arrivals (events per timestep, averaged over the run)
+        ArrivalProcess arrivals = ArrivalProcess::Poisson;
+        double arrivalRate = 2.0;
+        double burstFactor = 8.0;       // Bursty: rate multiplier while in a burst
+        double burstFraction = 0.1;     // Bursty: share of time spent in bursts
+        double burstLength = 20.0;      // Bursty: mean burst duration
+        double diurnalPeriod = 1440.0;  // Diurnal: length of a "day" in timesteps
+        double diurnalAmplitude = 0.8;  // Diurnal: 0 = flat, 1 = rate touches zero at night
+
+        // Orders
+        double vipRatio = 0.2;
+        int minLines = 1;
+        int maxLines = 4;
+        SizeDistribution sizeDistribution = SizeDistribution::Geometric;
+        double meanQuantity = 8.0;
+        int maxQuantity = 100;
+        double itemSkew = 0.8;          // Zipf exponent for item popularity (0 = uniform)
+        int minSlack = 10;              // DueBy = arrival + slack
+        int maxSlack = 80;
+
+        // Non-order events, as a fraction of all events
+        double cancelRate = 0.03;
+        double maintenanceRate = 0.01;
+        double restockRate = 0.05;
+        double rerouteRate = 0.01;
+
+        // Initial state
+        int minStock = 50;
+        int maxStock = 200;
+        double refrigeratedRatio = 0.25;
+    };
+
+    explicit ScenarioGenerator(const Config& config);
+
+    // Writes the complete scenario; memory use is O(W + N + V), independent of event count
+    bool generate(ScenarioWriter& writer);
+
+    std::string getError() const { return m_error; }
+
+    static bool parseTopology(const std::string& name, Topology& out);
+    static bool parseArrivalProcess(const std::string& name, ArrivalProcess& out);
+    static bool parseSizeDistribution(const std::string& name, SizeDistribution& out);
+
+private:
+    // xoshiro256** seeded through splitmix64
+    uint64_t nextRandom();
+    double uniform();                       // [0, 1)
+    int uniformInt(int lo, int hi);         // [lo, hi]
+    double exponential(double rate);
+    double normal();
+
+    void placeNodes();
+    int travelTime(int from, int to) const;
+    void buildItemPopularity();
+    int sampleItem();
+    int sampleQuantity();
+    double nextArrivalTime(double now);
+    double rateAt(double t) const;
+
+    void writeMatrix(ScenarioWriter& writer);
+    void writeVehicles(ScenarioWriter& writer);
+    void writeWarehouses(ScenarioWriter& writer);
+    void writeCoords(ScenarioWriter& writer);
+    void writeEvents(ScenarioWriter& writer);
+
+    Config m_config;
+    uint64_t m_state[4];
+
+    std::vector<double> m_nodeX;
+    std::vector<double> m_nodeY;
+    double m_distanceScale;
+    std::vector<double> m_itemCdf;
+
+    bool m_inBurst;
+    double m_burstEnds;
+
+    std::string m_error;
+};
+
+#endif // SCENARIOGENERATOR_H